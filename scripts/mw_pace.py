@@ -46,10 +46,10 @@ def get_parser():
     return parser
 
 
-def bench_cpp(G: nx.Graph) -> tuple[int, float, str]:
-    elist = '\n'.join(f'{u} {v}' for u, v in G.edges())
-    proc = subprocess.Popen('build/Release/modular-bench', stdin=subprocess.PIPE, stdout=subprocess.PIPE)
-    out = proc.communicate(input=elist.encode('utf-8'))[0].decode('utf-8')
+def bench_cpp(path: str) -> tuple[int, float]:
+    # modular-bench reads PACE files natively
+    proc = subprocess.Popen(['build/Release/modular-bench', path], stdout=subprocess.PIPE)
+    out = proc.communicate()[0].decode('utf-8')
     lines = out.splitlines()
     return int(lines[0]), float(lines[1])
 
@@ -60,7 +60,7 @@ def bench_one_instance(path: str, num_iterations: int = 3):
     m = G.number_of_edges()
 
     for _ in range(num_iterations):
-        mw, elapsed = bench_cpp(G)
+        mw, elapsed = bench_cpp(path)
         print(f'{path},{n},{m},{mw},{elapsed}')
 
 
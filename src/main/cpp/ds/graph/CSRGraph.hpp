@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "ds/graph/Graph.hpp"
+#include "ds/graph/GraphBuilder.hpp"
+
+namespace ds {
+namespace graph {
+/**
+ * @brief Immutable graph in the compressed sparse row (CSR) representation.
+ *
+ * The neighbors of vertex v are stored contiguously in increasing order
+ * in `targets_[offsets_[v]]`, ..., `targets_[offsets_[v + 1] - 1]`.
+ *
+ * The arrays are either owned by the graph or borrowed from external memory (e.g. a mapped file)
+ * kept alive by a shared owner. Copies share the same immutable arrays.
+ */
+class CSRGraph {
+ public:
+  typedef GraphBuilder::offset_type offset_type;
+
+  /**
+   * @brief Non-owning view of the neighbors of one vertex.
+   */
+  class NeighborRange {
+   private:
+    int const* begin_;
+    int const* end_;
+
+   public:
+    NeighborRange(int const* begin, int const* end) : begin_(begin), end_(end) {}
+
+    int const* begin() const { return begin_; }
+    int const* end() const { return end_; }
+    std::size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    int operator[](std::size_t i) const { return begin_[i]; }
+  };
+
+ private:
+  struct Storage {
+    std::vector<offset_type> offsets;
+    std::vector<int> targets;
+  };
+
+  /** Number of vertices. */
+  std::size_t n_;
+
+  /** Number of edges. */
+  std::size_t m_;
+
+  /** Starting position of the neighbors for each vertex; has n + 1 entries. */
+  offset_type const* offsets_;
+
+  /** Concatenation of the sorted neighbors; has 2m entries. */
+  int const* targets_;
+
+  /** Keeps the arrays alive. */
+  std::shared_ptr<void const> owner_;
+
+  void assign(std::shared_ptr<Storage> storage) {
+    n_ = storage->offsets.size() - 1;
+    m_ = storage->targets.size() / 2;
+    offsets_ = storage->offsets.data();
+    targets_ = storage->targets.data();
+    owner_ = std::move(storage);
+  }
+
+ public:
+  CSRGraph() { assign(std::make_shared<Storage>(Storage{{0}, {}})); }
+
+  /**
+   * @brief Constructs a graph from an edge list in linear time.
+   * Self-loops and duplicate edges are ignored.
+   *
+   * @param n number of vertices
+   * @param edges list of edges
+   * @param num_threads number of threads used for building
+   */
+  CSRGraph(std::size_t n, std::vector<std::pair<int, int>> const& edges, int num_threads = 1) {
+    auto storage = std::make_shared<Storage>();
+    GraphBuilder::build_adjacency(n, edges, num_threads, storage->offsets, storage->targets);
+    assign(std::move(storage));
+  }
+
+  /**
+   * @brief Constructs a graph from the edges collected by the given builder.
+   */
+  explicit CSRGraph(GraphBuilder const& builder) {
+    auto storage = std::make_shared<Storage>();
+    builder.build(storage->offsets, storage->targets);
+    assign(std::move(storage));
+  }
+
+  /**
+   * @brief Constructs a graph by taking over the given CSR arrays.
+   *
+   * @param offsets n + 1 entries
+   * @param targets 2m entries; sorted, duplicate-free and symmetric adjacency
+   */
+  CSRGraph(std::vector<offset_type>&& offsets, std::vector<int>&& targets) {
+    assign(std::make_shared<Storage>(Storage{std::move(offsets), std::move(targets)}));
+  }
+
+  /**
+   * @brief Constructs a graph on external arrays without copying.
+   *
+   * The arrays must be in the CSR layout with sorted, duplicate-free and symmetric adjacency.
+   *
+   * @param n number of vertices
+   * @param m number of edges
+   * @param offsets n + 1 entries
+   * @param targets 2m entries
+   * @param owner object that keeps the arrays alive
+   */
+  CSRGraph(std::size_t n, std::size_t m, offset_type const* offsets, int const* targets,
+           std::shared_ptr<void const> owner)
+      : n_(n), m_(m), offsets_(offsets), targets_(targets), owner_(std::move(owner)) {}
+
+  /**
+   * @brief Constructs a snapshot of the given graph.
+   *
+   * @param graph graph without removed vertices
+   */
+  explicit CSRGraph(Graph const& graph) {
+    int n = graph.number_of_nodes();
+    auto storage = std::make_shared<Storage>();
+    auto& offsets = storage->offsets;
+    auto& targets = storage->targets;
+
+    offsets.assign(n + 1, 0);
+    for (int v = 0; v < n; ++v) offsets[v + 1] = offsets[v] + graph.degree(v);
+
+    targets.reserve(offsets[n]);
+    for (int v = 0; v < n; ++v) {
+      for (auto u : graph.neighbors(v)) {
+        if (u >= n) throw std::invalid_argument("CSRGraph: graph must not have removed vertices");
+        targets.push_back(u);
+      }
+    }
+    assign(std::move(storage));
+  }
+
+  std::size_t number_of_nodes() const { return n_; }
+  std::size_t number_of_edges() const { return m_; }
+
+  /** Raw CSR arrays; n + 1 and 2m entries, respectively. */
+  offset_type const* offsets() const { return offsets_; }
+  int const* targets() const { return targets_; }
+
+  NeighborRange neighbors(int v) const {
+    return NeighborRange(targets_ + offsets_[v], targets_ + offsets_[v + 1]);
+  }
+
+  int degree(int v) const { return offsets_[v + 1] - offsets_[v]; }
+
+  bool has_vertex(int v) const { return 0 <= v && v < static_cast<int>(number_of_nodes()); }
+
+  bool has_edge(int u, int v) const {
+    if (!has_vertex(u) || !has_vertex(v) || u == v) return false;
+    if (degree(u) > degree(v)) std::swap(u, v);
+    auto nbrs = neighbors(u);
+    return std::binary_search(nbrs.begin(), nbrs.end(), v);
+  }
+};
+}  // namespace graph
+}  // namespace ds
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include "ds/graph/GraphBuilder.hpp"
 #include "ds/set/ArrayBitset.hpp"
+#include "ds/set/Bitmap.hpp"
 #include "ds/set/SortedVectorSet.hpp"
 
 namespace ds {
@@ -30,7 +32,7 @@ class Graph {
 
   bool is_valid(int v) const { return 0 <= v && v < static_cast<int>(adj_.size()) && !removed_->get(v); }
 
-    std::unique_ptr<basic_set<int>> create_set(std::size_t n, bool dense) {
+  std::unique_ptr<basic_set<int>> create_set(std::size_t n, bool dense) {
     if (dense) {
       if (n <= 1 << 6) {
         return std::make_unique<ArrayBitset6>(n);
@@ -49,24 +51,132 @@ class Graph {
       } else if (n <= 1 << 13) {
         return std::make_unique<ArrayBitset13>(n);
       } else {
-        throw std::invalid_argument("Graph: n too large for dense representation");
+        return std::make_unique<Bitmap>(n);
       }
     } else {
       return std::make_unique<SortedVectorSet>();
     }
   }
 
+  /**
+   * @brief Fills the adjacency sets from sorted, duplicate-free CSR arrays.
+   */
+  void assign(GraphBuilder::offset_type const* offsets, int const* targets) {
+    adj_.reserve(n_);
+    for (std::size_t v = 0; v < n_; ++v) {
+      if (dense_) {
+        adj_.push_back(create_set(n_, true));
+        for (auto i = offsets[v]; i < offsets[v + 1]; ++i) adj_.back()->set(targets[i]);
+      } else {
+        adj_.push_back(
+            std::make_unique<SortedVectorSet>(std::vector<int>(targets + offsets[v], targets + offsets[v + 1])));
+      }
+    }
+    removed_ = create_set(n_, dense_);
+    m_ = offsets[n_] / 2;
+  }
+
+  void assign(std::vector<GraphBuilder::offset_type> const& offsets, std::vector<int> const& targets) {
+    assign(offsets.data(), targets.data());
+  }
+
  public:
+  /**
+   * @brief Constructs a graph from an edge list in linear time.
+   * Self-loops and duplicate edges are ignored.
+   * The default sparse representation can grow, so vertices can be added by `add_vertex()`.
+   */
   Graph(std::size_t n = 0, std::vector<std::pair<int, int>> const& edges = {}, bool dense = false)
       : n_(n), m_(0), dense_(dense) {
-    for (int i = 0; i < static_cast<int>(n); ++i) adj_.push_back(create_set(n, dense));
-    removed_ = create_set(n, dense);
-    for (auto& p : edges) add_edge(p.first, p.second);
+    std::vector<GraphBuilder::offset_type> offsets;
+    std::vector<int> targets;
+    GraphBuilder::build_adjacency(n, edges, 1, offsets, targets);
+    assign(offsets, targets);
+  }
+
+  /**
+   * @brief Constructs a graph from the edges collected by the given builder.
+   * The representation is chosen by `prefers_dense()`.
+   */
+  explicit Graph(GraphBuilder const& builder) : n_(builder.number_of_nodes()), m_(0), dense_(false) {
+    std::vector<GraphBuilder::offset_type> offsets;
+    std::vector<int> targets;
+    builder.build(offsets, targets);
+    dense_ = prefers_dense(n_, targets.size() / 2);
+    assign(offsets, targets);
+  }
+
+  /**
+   * @brief Constructs a graph from the edges collected by the given builder.
+   */
+  Graph(GraphBuilder const& builder, bool dense) : n_(builder.number_of_nodes()), m_(0), dense_(dense) {
+    std::vector<GraphBuilder::offset_type> offsets;
+    std::vector<int> targets;
+    builder.build(offsets, targets);
+    assign(offsets, targets);
+  }
+
+  /**
+   * @brief Constructs a graph from sorted, duplicate-free CSR arrays (e.g. those of a CSRGraph).
+   * The representation is chosen by `prefers_dense()`.
+   *
+   * @param n number of vertices
+   * @param offsets n + 1 entries
+   * @param targets offsets[n] entries
+   */
+  Graph(std::size_t n, GraphBuilder::offset_type const* offsets, int const* targets)
+      : n_(n), m_(0), dense_(prefers_dense(n, offsets[n] / 2)) {
+    assign(offsets, targets);
+  }
+
+  /**
+   * @brief Constructs a graph by taking over sorted, duplicate-free and symmetric adjacency lists.
+   * The representation is chosen by `prefers_dense()`. Sparse sets keep the lists without copying,
+   * and bitsets are filled from one list at a time, which is freed right after.
+   */
+  explicit Graph(std::vector<std::vector<int>>&& adj) : n_(adj.size()), m_(0), dense_(false) {
+    std::size_t arcs = 0;
+    for (auto& a : adj) arcs += a.size();
+    dense_ = prefers_dense(n_, arcs / 2);
+
+    adj_.reserve(n_);
+    for (auto& a : adj) {
+      if (dense_) {
+        adj_.push_back(create_set(n_, true));
+        for (auto u : a) adj_.back()->set(u);
+        std::vector<int>().swap(a);
+      } else {
+        adj_.push_back(std::make_unique<SortedVectorSet>(std::move(a)));
+      }
+    }
+    removed_ = create_set(n_, dense_);
+    m_ = arcs / 2;
+  }
+
+  /**
+   * @brief Decides the representation of the adjacency sets (see ds/set/README.md).
+   *
+   * Bitsets win for small graphs and for graphs with edge density m/n^2 of at least 1/256,
+   * as long as the n^2 bits fit in a reasonable amount of memory (n < 2^18).
+   *
+   * @param n number of vertices
+   * @param m number of edges
+   * @return true if the dense representation is preferable
+   */
+  static bool prefers_dense(std::size_t n, std::size_t m) {
+    if (n < 1 << 12) return true;
+    if (n >= 1 << 18) return false;
+    return m * 256 >= n * n;
   }
 
   std::size_t number_of_nodes() const { return n_; }
   std::size_t number_of_edges() const { return m_; }
 
+  /**
+   * @brief Returns true if the adjacency sets are bitsets.
+   */
+  bool is_dense() const { return dense_; }
+
   int add_vertex() {
     int x;
     if (removed_->empty()) {  // all vertices are in use
@@ -103,7 +213,7 @@ class Graph {
     --n_;
     m_ -= adj_[v]->size();
 
-    for (auto u : adj_[v]->to_vector()) adj_[u]->reset(v);
+    for (auto u : adj_[v]->range()) adj_[u]->reset(v);
     adj_[v]->clear();
     removed_->set(v);
   }
@@ -118,7 +228,11 @@ class Graph {
     --m_;
   }
 
-  std::vector<int> neighbors(int v) const { return adj_[v]->to_vector(); }
+  /**
+   * @brief Returns a non-owning view of the neighbors of the given vertex in increasing order.
+   * The view is invalidated when the adjacency of v is modified.
+   */
+  SetRange neighbors(int v) const { return adj_[v]->range(); }
 
   int degree(int v) const { return adj_[v]->size(); }
 
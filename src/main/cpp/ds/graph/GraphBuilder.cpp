@@ -0,0 +1,202 @@
+#include "GraphBuilder.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "util/parallel.hpp"
+
+namespace ds {
+namespace graph {
+
+namespace {
+// minimum number of edges per thread; smaller inputs are not worth spawning threads
+std::size_t const MIN_EDGES_PER_THREAD = 1 << 16;
+}  // namespace
+
+/**
+ * @brief Builds adjacency from the given edge list with two passes of counting sort.
+ *
+ * (1) Bucket the arcs (both directions of each edge) by source.
+ * (2) Scan the buckets in increasing order and redistribute each arc (x, s) to the bucket of s,
+ *     which leaves every bucket sorted; the arc counts are equal because the arcs are symmetric.
+ * (3) Drop adjacent duplicates and compact.
+ *
+ * With multiple threads, every pass is split into chunks whose write positions are
+ * computed from per-thread counters, so no synchronization is needed.
+ */
+void GraphBuilder::build_adjacency(std::size_t n, std::vector<std::pair<int, int>> const& edges, int num_threads,
+                                   std::vector<offset_type>& offsets, std::vector<int>& targets) {
+  std::size_t m = edges.size();
+  int k = static_cast<int>(std::max<std::size_t>(
+      1, std::min<std::size_t>(util::resolve_num_threads(num_threads), m / MIN_EDGES_PER_THREAD)));
+
+  // pos[t][v]: number of arcs for v in chunk t, and then the write position for chunk t
+  std::vector<std::vector<offset_type>> pos(k, std::vector<offset_type>(n));
+  std::atomic<bool> invalid(false);
+
+  //--------------------------------------------------------------------------
+  // (1) bucket arcs by source
+  //--------------------------------------------------------------------------
+  util::parallel_for(k, [&](int t) {
+    auto& cnt = pos[t];
+    for (std::size_t i = util::chunk_begin(m, t, k); i < util::chunk_begin(m, t + 1, k); ++i) {
+      int u = edges[i].first, v = edges[i].second;
+      if (u < 0 || static_cast<int>(n) <= u || v < 0 || static_cast<int>(n) <= v) {
+        invalid = true;
+        return;
+      }
+      if (u == v) continue;  // drop loops
+      ++cnt[u];
+      ++cnt[v];
+    }
+  });
+  if (invalid) throw std::invalid_argument("build_adjacency: invalid vertex");
+
+  offsets.assign(n + 1, 0);
+  for (std::size_t v = 0; v < n; ++v) {
+    auto p = offsets[v];
+    for (int t = 0; t < k; ++t) {
+      auto c = pos[t][v];
+      pos[t][v] = p;
+      p += c;
+    }
+    offsets[v + 1] = p;
+  }
+
+  std::vector<int> raw(offsets[n]);
+  util::parallel_for(k, [&](int t) {
+    auto& p = pos[t];
+    for (std::size_t i = util::chunk_begin(m, t, k); i < util::chunk_begin(m, t + 1, k); ++i) {
+      int u = edges[i].first, v = edges[i].second;
+      if (u == v) continue;
+      raw[p[u]++] = v;
+      raw[p[v]++] = u;
+    }
+  });
+  std::vector<std::vector<offset_type>>().swap(pos);
+
+  sort_adjacency(n, num_threads, offsets, raw, targets);
+}
+
+/**
+ * @brief Sorts bucketed arcs and drops duplicates; steps (2) and (3) of build_adjacency().
+ */
+void GraphBuilder::sort_adjacency(std::size_t n, int num_threads, std::vector<offset_type>& offsets,
+                                  std::vector<int>& raw, std::vector<int>& targets) {
+  int k = static_cast<int>(std::max<std::size_t>(
+      1, std::min<std::size_t>(util::resolve_num_threads(num_threads), raw.size() / 2 / MIN_EDGES_PER_THREAD)));
+  std::vector<std::vector<offset_type>> pos(k, std::vector<offset_type>(n));
+
+  //--------------------------------------------------------------------------
+  // (2) redistribute arcs in increasing order of sources
+  //--------------------------------------------------------------------------
+  // split vertices into chunks with almost the same number of arcs
+  std::vector<std::size_t> bounds(k + 1, n);
+  for (int t = 0; t < k; ++t) {
+    bounds[t] =
+        std::lower_bound(offsets.begin(), offsets.end() - 1, util::chunk_begin(offsets[n], t, k)) - offsets.begin();
+  }
+
+  util::parallel_for(k, [&](int t) {
+    auto& cnt = pos[t];
+    std::fill(cnt.begin(), cnt.end(), 0);
+    for (auto i = offsets[bounds[t]]; i < offsets[bounds[t + 1]]; ++i) ++cnt[raw[i]];
+  });
+
+  for (std::size_t s = 0; s < n; ++s) {
+    auto p = offsets[s];
+    for (int t = 0; t < k; ++t) {
+      auto c = pos[t][s];
+      pos[t][s] = p;
+      p += c;
+    }
+  }
+
+  std::vector<int> sorted(offsets[n]);
+  util::parallel_for(k, [&](int t) {
+    auto& p = pos[t];
+    for (auto x = bounds[t]; x < bounds[t + 1]; ++x) {
+      for (auto i = offsets[x]; i < offsets[x + 1]; ++i) sorted[p[raw[i]]++] = x;
+    }
+  });
+  std::vector<int>().swap(raw);
+  std::vector<std::vector<offset_type>>().swap(pos);
+
+  //--------------------------------------------------------------------------
+  // (3) drop duplicates
+  //--------------------------------------------------------------------------
+  if (k == 1) {
+    // compact in place
+    offset_type j = 0;
+    for (std::size_t v = 0; v < n; ++v) {
+      auto b = offsets[v], e = offsets[v + 1];
+      offsets[v] = j;
+      for (auto i = b; i < e; ++i) {
+        if (i == b || sorted[i] != sorted[i - 1]) sorted[j++] = sorted[i];
+      }
+    }
+    offsets[n] = j;
+    sorted.resize(j);
+    sorted.shrink_to_fit();
+    targets.swap(sorted);
+    return;
+  }
+
+  std::vector<offset_type> new_offsets(n + 1, 0);
+  util::parallel_for(k, [&](int t) {
+    for (auto v = bounds[t]; v < bounds[t + 1]; ++v) {
+      auto b = offsets[v], e = offsets[v + 1], j = b;
+      for (auto i = b; i < e; ++i) {
+        if (i == b || sorted[i] != sorted[i - 1]) sorted[j++] = sorted[i];
+      }
+      new_offsets[v + 1] = j - b;
+    }
+  });
+  for (std::size_t v = 0; v < n; ++v) new_offsets[v + 1] += new_offsets[v];
+
+  targets.resize(new_offsets[n]);
+  util::parallel_for(k, [&](int t) {
+    for (auto v = bounds[t]; v < bounds[t + 1]; ++v) {
+      std::copy(sorted.begin() + offsets[v], sorted.begin() + offsets[v] + (new_offsets[v + 1] - new_offsets[v]),
+                targets.begin() + new_offsets[v]);
+    }
+  });
+  offsets.swap(new_offsets);
+}
+
+void GraphBuilder::sort_adjacency_in_place(std::size_t n, int num_threads, std::vector<offset_type>& offsets,
+                                           std::vector<int>& targets) {
+  int k = static_cast<int>(std::max<std::size_t>(
+      1, std::min<std::size_t>(util::resolve_num_threads(num_threads), targets.size() / 2 / MIN_EDGES_PER_THREAD)));
+
+  // split vertices into chunks with almost the same number of arcs
+  std::vector<std::size_t> bounds(k + 1, n);
+  for (int t = 0; t < k; ++t) {
+    bounds[t] =
+        std::lower_bound(offsets.begin(), offsets.end() - 1, util::chunk_begin(offsets[n], t, k)) - offsets.begin();
+  }
+
+  // sort and deduplicate each bucket; sizes[v] is the deduplicated degree of v
+  std::vector<offset_type> sizes(n);
+  util::parallel_for(k, [&](int t) {
+    for (auto v = bounds[t]; v < bounds[t + 1]; ++v) {
+      auto b = targets.begin() + offsets[v], e = targets.begin() + offsets[v + 1];
+      std::sort(b, e);
+      sizes[v] = std::unique(b, e) - b;
+    }
+  });
+
+  // compact; buckets only move left, so copying in increasing order of vertices is safe
+  offset_type j = 0;
+  for (std::size_t v = 0; v < n; ++v) {
+    auto b = offsets[v];
+    offsets[v] = j;
+    if (j != b) std::copy(targets.begin() + b, targets.begin() + b + sizes[v], targets.begin() + j);
+    j += sizes[v];
+  }
+  offsets[n] = j;
+  targets.resize(j);  // no shrink_to_fit(), which would copy the arcs once more
+}
+
+}  // namespace graph
+}  // namespace ds
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace ds {
+namespace graph {
+/**
+ * @brief Collects an edge list and builds sorted, duplicate-free adjacency in linear time.
+ *
+ * Self-loops and duplicate edges are dropped.
+ * The resulting adjacency is in the compressed sparse row (CSR) layout:
+ * the neighbors of vertex v are `targets[offsets[v]]`, ..., `targets[offsets[v + 1] - 1]` in increasing order.
+ */
+class GraphBuilder {
+ public:
+  typedef uint64_t offset_type;
+
+ private:
+  std::size_t n_;
+  int num_threads_;
+  std::vector<std::pair<int, int>> edges_;
+
+ public:
+  /**
+   * @brief Constructs a builder.
+   *
+   * @param n number of vertices
+   * @param num_threads number of threads used for building
+   */
+  GraphBuilder(std::size_t n = 0, int num_threads = 1) : n_(n), num_threads_(num_threads) {}
+
+  std::size_t number_of_nodes() const { return n_; }
+
+  void reserve(std::size_t m) { edges_.reserve(m); }
+
+  void add_edge(int u, int v) {
+    if (u < 0 || static_cast<int>(n_) <= u) throw std::invalid_argument("add_edge: invalid u");
+    if (v < 0 || static_cast<int>(n_) <= v) throw std::invalid_argument("add_edge: invalid v");
+    edges_.push_back({u, v});
+  }
+
+  void add_edges(std::vector<std::pair<int, int>> const& edges) {
+    for (auto& p : edges) add_edge(p.first, p.second);
+  }
+
+  /**
+   * @brief Builds the adjacency of the edges added so far.
+   *
+   * @param offsets output; n + 1 entries
+   * @param targets output; 2m entries
+   */
+  void build(std::vector<offset_type>& offsets, std::vector<int>& targets) const {
+    build_adjacency(n_, edges_, num_threads_, offsets, targets);
+  }
+
+  /**
+   * @brief Builds adjacency from the given edge list with two passes of counting sort.
+   *
+   * O(n * num_threads + m) time.
+   *
+   * @param n number of vertices
+   * @param edges edge list; every label must be between 0 and n - 1
+   * @param num_threads number of threads
+   * @param offsets output; n + 1 entries
+   * @param targets output; 2m entries
+   */
+  static void build_adjacency(std::size_t n, std::vector<std::pair<int, int>> const& edges, int num_threads,
+                              std::vector<offset_type>& offsets, std::vector<int>& targets);
+
+  /**
+   * @brief Builds adjacency from arcs already bucketed by source.
+   *
+   * O(n * num_threads + m) time.
+   *
+   * @param n number of vertices
+   * @param num_threads number of threads
+   * @param offsets n + 1 entries; bucket boundaries on input, and adjacency offsets on output
+   * @param raw arcs in any order within each bucket; must be symmetric and loop-free; consumed
+   * @param targets output; 2m entries
+   */
+  static void sort_adjacency(std::size_t n, int num_threads, std::vector<offset_type>& offsets,
+                             std::vector<int>& raw, std::vector<int>& targets);
+
+  /**
+   * @brief Sorts arcs bucketed by source within their buckets and drops duplicates, without a second arc array.
+   *
+   * O(m log Δ) time, where Δ is the maximum degree; the extra space is O(n) instead of 2m.
+   * Capacity freed by duplicates is not returned.
+   *
+   * @param n number of vertices
+   * @param num_threads number of threads
+   * @param offsets n + 1 entries; bucket boundaries on input, and adjacency offsets on output
+   * @param targets arcs in any order within each bucket on input, and sorted adjacency on output
+   */
+  static void sort_adjacency_in_place(std::size_t n, int num_threads, std::vector<offset_type>& offsets,
+                                      std::vector<int>& targets);
+};
+}  // namespace graph
+}  // namespace ds
@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include "ds/set/basic_set.hpp"
@@ -244,6 +245,11 @@ class ArrayBitset : public basic_set<int> {
     return ret;
   }
 
+  SetRange range() const {
+    static_assert(std::is_same<DataType, SetRange::word_type>::value, "range() requires 64-bit words");
+    return SetRange(data_, N);
+  }
+
   /**
    * equality
    */
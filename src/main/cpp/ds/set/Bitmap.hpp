@@ -3,11 +3,13 @@
 #pragma GCC optimize("Ofast,inline,unroll-loops")  // Ofast = O3,fast-math,allow-store-data-races,no-protect-parens
 
 #include <algorithm>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
+#include "ds/set/basic_set.hpp"
 #include "util/util.hpp"
 
 namespace ds {
@@ -15,10 +17,10 @@ namespace ds {
 /**
  * Bitmap of variable length.
  */
-class Bitmap {
+class Bitmap : public basic_set<int> {
  private:
   // typedef unsigned int data_type;
-  typedef unsigned long long data_type;  // best for general purposes
+  typedef uint64_t data_type;  // best for general purposes
   // typedef __uint128_t data_type;
   static constexpr bool const validation_enabled = false;
 
@@ -76,7 +78,7 @@ class Bitmap {
     data_ = other.data_;
   }
 
-  inline std::size_t capacity() const { return n_; }
+  int capacity() const { return n_; }
 
   inline void clear() {
     for (std::size_t i = 0; i < data_.size(); ++i) data_[i] = 0;
@@ -113,6 +115,19 @@ class Bitmap {
     return -1;
   }
 
+  inline int back() const {
+    for (int i = static_cast<int>(data_.size()) - 1; i >= 0; --i) {
+      if (data_[i]) return i * B + (B - 1 - __builtin_clzll(data_[i]));
+    }
+    return -1;
+  }
+
+  inline int pop_back() {
+    int ret = back();
+    if (ret >= 0) data_[ret / B] ^= ONE << (ret % B);
+    return ret;
+  }
+
   //--------------------------------------------------------
   //    Operators
   //--------------------------------------------------------
@@ -230,6 +245,8 @@ class Bitmap {
     return ret;
   }
 
+  SetRange range() const { return SetRange(data_.data(), data_.size()); }
+
   /**
    * equality
    */
@@ -275,7 +292,7 @@ class Bitmap {
   std::size_t size() const { return count(); }
   void set(int x) { *this |= x; }
   void reset(int x) { *this -= x; }
-  bool get(int x) { return (*this)[x]; }
+  bool get(int x) const { return (*this)[x]; }
   static Bitmap intersect(Bitmap const& s, Bitmap const& t) { return s & t; }
   static Bitmap Union(Bitmap const& s, Bitmap const& t) { return s | t; }
 };
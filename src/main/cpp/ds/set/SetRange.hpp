@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+
+namespace ds {
+/**
+ * @brief Non-owning, read-only range over the elements of an integer set.
+ *
+ * Views either a sorted array of elements or an array of 64-bit words (bitset).
+ * Elements are enumerated in increasing order without allocation.
+ * The range is invalidated when the underlying set is modified.
+ */
+class SetRange {
+ public:
+  typedef uint64_t word_type;
+
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef int const* pointer;
+    typedef int reference;
+
+   private:
+    int const* ptr_;          // current element for sorted arrays
+    word_type const* words_;  // nullptr for sorted arrays
+    std::size_t index_;       // current word index for bitsets
+    std::size_t num_words_;
+    word_type current_;  // remaining bits in the current word
+
+    void skip_empty_words() {
+      while (current_ == 0 && ++index_ < num_words_) current_ = words_[index_];
+    }
+
+   public:
+    const_iterator(int const* ptr) : ptr_(ptr), words_(nullptr), index_(0), num_words_(0), current_(0) {}
+
+    const_iterator(word_type const* words, std::size_t index, std::size_t num_words)
+        : ptr_(nullptr), words_(words), index_(index), num_words_(num_words), current_(0) {
+      if (index_ < num_words_) {
+        current_ = words_[index_];
+        skip_empty_words();
+      }
+    }
+
+    int operator*() const {
+      return words_ ? static_cast<int>(index_ * 64 + __builtin_ctzll(current_)) : *ptr_;
+    }
+
+    const_iterator& operator++() {
+      if (words_) {
+        current_ &= current_ - 1;
+        skip_empty_words();
+      } else {
+        ++ptr_;
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    friend bool operator==(const_iterator const& lhs, const_iterator const& rhs) {
+      return lhs.words_ ? lhs.index_ == rhs.index_ && lhs.current_ == rhs.current_ : lhs.ptr_ == rhs.ptr_;
+    }
+
+    friend bool operator!=(const_iterator const& lhs, const_iterator const& rhs) { return !(lhs == rhs); }
+  };
+
+  typedef const_iterator iterator;
+
+ private:
+  const_iterator begin_;
+  const_iterator end_;
+
+ public:
+  /**
+   * @brief Views a sorted array of elements.
+   */
+  SetRange(int const* begin, int const* end) : begin_(begin), end_(end) {}
+
+  /**
+   * @brief Views a bitset stored in the given words.
+   */
+  SetRange(word_type const* words, std::size_t num_words)
+      : begin_(words, 0, num_words), end_(words, num_words, num_words) {}
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+  bool empty() const { return begin_ == end_; }
+};
+}  // namespace ds
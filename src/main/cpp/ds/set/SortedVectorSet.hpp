@@ -14,6 +14,11 @@ class SortedVectorSet : public basic_set<int> {
  public:
   SortedVectorSet() {}
 
+  /**
+   * @brief Constructs from elements that are already sorted and unique.
+   */
+  SortedVectorSet(std::vector<int>&& data) : data_(std::move(data)) {}
+
   std::size_t size() const { return data_.size(); }
 
   int capacity() const { return -1; }
@@ -39,6 +44,8 @@ class SortedVectorSet : public basic_set<int> {
 
   std::vector<int> to_vector() const { return data_; }
 
+  SetRange range() const { return SetRange(data_.data(), data_.data() + data_.size()); }
+
   int front() const { return empty() ? -1 : data_.front(); }
 
   int pop_front() {
@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include "ds/set/SetRange.hpp"
+
 namespace ds {
 template <typename T>
 class basic_set {
@@ -14,6 +16,7 @@ class basic_set {
   virtual bool empty() const = 0;
   virtual void clear() = 0;
   virtual std::vector<T> to_vector() const = 0;
+  virtual SetRange range() const = 0;  // enumerates elements without allocation
   virtual int front() const = 0;  // -1: not found
   virtual int pop_front() = 0;  // -1: not found
   virtual int back() const = 0;  // -1: not found
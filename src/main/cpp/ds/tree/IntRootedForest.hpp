@@ -1,10 +1,12 @@
 #pragma once
 
+#include <limits>
 #include <list>
-#include <queue>
 #include <stack>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "util/util.hpp"
@@ -19,120 +21,368 @@
 // validation: off
 #define VALIDATE(s)
 
-#define FOR_EACH_CHILD(c, p) for (auto c = nodes_[(p)].first_child; (c) != NOT_AVAILABLE; (c) = nodes_[(c)].right)
+#define FOR_EACH_CHILD(c, p) for (auto c = link(p).first_child; (c) != NOT_AVAILABLE; (c) = link(c).right)
 
 namespace ds {
 namespace tree {
 
+/** Storage layout tag: each node keeps its data and links together. */
+struct ArrayOfStructures {};
+
+/** Storage layout tag: node data and links are kept in separate arrays, so traversals touch only the links. */
+struct StructureOfArrays {};
+
+namespace detail {
+int const NOT_AVAILABLE = -1;
+
 /**
- * @brief Tree representation where each node has a unique integer.
- *
- * @tparam T type for node data
+ * @brief Utilities shared by the node types; `Derived` provides the link fields.
  */
-template <typename T>
-class IntRootedForest {
+template <typename Derived, typename Index>
+class NodeBase {
+ private:
+  static Index const NA = static_cast<Index>(NOT_AVAILABLE);
+
+  Derived const& self() const { return static_cast<Derived const&>(*this); }
+
+ public:
+  bool is_alive() const { return self().alive; }
+  bool is_root() const { return self().parent == NA; }
+  bool has_parent() const { return self().parent != NA; }
+  bool is_first_child() const { return has_parent() && self().left == NA; }
+  bool is_last_child() const { return has_parent() && self().right == NA; }
+  bool is_leaf() const { return self().first_child == NA; }
+  bool has_child() const { return self().first_child != NA; }
+  bool has_only_one_child() const { return self().num_children == 1; }
+  Index number_of_children() const { return self().num_children; }
+};
+
+/**
+ * @brief Links of a node in the forest.
+ */
+template <typename Index>
+class NodeLinks : public NodeBase<NodeLinks<Index>, Index> {
  public:
-  static int const NOT_AVAILABLE = -1;
+  Index parent;
+  Index left;
+  Index right;
+  Index first_child;
+  Index num_children;
+  bool alive;
+
+  NodeLinks()
+      : parent(static_cast<Index>(NOT_AVAILABLE)),
+        left(static_cast<Index>(NOT_AVAILABLE)),
+        right(static_cast<Index>(NOT_AVAILABLE)),
+        first_child(static_cast<Index>(NOT_AVAILABLE)),
+        num_children(0),
+        alive(true) {}
+};
 
- private:
+/**
+ * @brief Node data and links referring to separate arrays; behaves like a node of the array-of-structures layout.
+ */
+template <typename T, typename Int, typename Bool>
+class NodeRef : public NodeBase<NodeRef<T, Int, Bool>, typename std::remove_const<Int>::type> {
+ public:
+  T& data;
+  Int& parent;
+  Int& left;
+  Int& right;
+  Int& first_child;
+  Int& num_children;
+  Bool& alive;
+
+  template <typename Links>
+  NodeRef(T& data, Links& links)
+      : data(data),
+        parent(links.parent),
+        left(links.left),
+        right(links.right),
+        first_child(links.first_child),
+        num_children(links.num_children),
+        alive(links.alive) {}
+};
+
+template <typename T, typename Layout, typename Index>
+class ForestStorage;
+
+template <typename T, typename Index>
+class ForestStorage<T, ArrayOfStructures, Index> {
+ public:
   /**
    * @brief Represents a node in the forest.
    */
-  class Node {
+  class Node : public NodeLinks<Index> {
    public:
-    // Fields
     T data;
-    int parent;
-    int left;
-    int right;
-    int first_child;
-    int num_children;
-    bool alive;
-
-   public:
-    // Constructor
-    Node(T const& data)
-        : data(data),
-          parent(NOT_AVAILABLE),
-          left(NOT_AVAILABLE),
-          right(NOT_AVAILABLE),
-          first_child(NOT_AVAILABLE),
-          num_children(0),
-          alive(true) {}
-
-    // Copy constructor
-    Node(Node const& node)
-        : data(node.data),
-          parent(node.parent),
-          left(node.left),
-          right(node.right),
-          first_child(node.first_child),
-          num_children(node.num_children),
-          alive(node.alive) {}
-
-    // Assignment operator
-    void operator=(Node const& node) {
-      data = node.data;
-      parent = node.parent;
-      left = node.left;
-      right = node.right;
-      first_child = node.first_child;
-      num_children = node.num_children;
-      alive = node.alive;
-    }
 
-    // Utilities
-    bool is_alive() const { return alive; }
-    bool is_root() const { return parent == NOT_AVAILABLE; }
-    bool has_parent() const { return parent != NOT_AVAILABLE; }
-    bool is_first_child() const { return has_parent() && left == NOT_AVAILABLE; }
-    bool is_last_child() const { return has_parent() && right == NOT_AVAILABLE; }
-    bool is_leaf() const { return first_child == NOT_AVAILABLE; }
-    bool has_child() const { return first_child != NOT_AVAILABLE; }
-    bool has_only_one_child() const { return num_children == 1; }
-    int number_of_children() const { return num_children; }
+    Node(T const& data) : data(data) {}
   };
 
+  typedef Node& reference;
+  typedef Node const& const_reference;
+
+ private:
   std::vector<Node> nodes_;
-  std::queue<int> removed_;  // queue of removed indices
+
+ public:
+  std::size_t size() const { return nodes_.size(); }
+  void clear() { nodes_.clear(); }
+  void push_back(T const& x) { nodes_.emplace_back(x); }
+  void reset(std::size_t index, T const& x) { nodes_[index] = Node(x); }
+  void swap(std::size_t a, std::size_t b) { std::swap(nodes_[a], nodes_[b]); }
+  void truncate(std::size_t size) { nodes_.erase(nodes_.begin() + size, nodes_.end()); }
+
+  NodeLinks<Index>& links(std::size_t index) { return nodes_[index]; }
+  NodeLinks<Index> const& links(std::size_t index) const { return nodes_[index]; }
+  T const& data(std::size_t index) const { return nodes_[index].data; }
+  reference operator[](std::size_t index) { return nodes_[index]; }
+  const_reference operator[](std::size_t index) const { return nodes_[index]; }
+};
+
+template <typename T, typename Index>
+class ForestStorage<T, StructureOfArrays, Index> {
+ public:
+  typedef NodeRef<T, Index, bool> reference;
+  typedef NodeRef<T const, Index const, bool const> const_reference;
+
+ private:
+  std::vector<NodeLinks<Index>> links_;
+  std::vector<T> data_;
+
+ public:
+  std::size_t size() const { return links_.size(); }
+  void clear() {
+    links_.clear();
+    data_.clear();
+  }
+  void push_back(T const& x) {
+    links_.emplace_back();
+    data_.push_back(x);
+  }
+  void reset(std::size_t index, T const& x) {
+    links_[index] = NodeLinks<Index>();
+    data_[index] = x;
+  }
+  void swap(std::size_t a, std::size_t b) {
+    std::swap(links_[a], links_[b]);
+    std::swap(data_[a], data_[b]);
+  }
+  void truncate(std::size_t size) {
+    links_.erase(links_.begin() + size, links_.end());
+    data_.erase(data_.begin() + size, data_.end());
+  }
+
+  NodeLinks<Index>& links(std::size_t index) { return links_[index]; }
+  NodeLinks<Index> const& links(std::size_t index) const { return links_[index]; }
+  T const& data(std::size_t index) const { return data_[index]; }
+  reference operator[](std::size_t index) { return reference(data_[index], links_[index]); }
+  const_reference operator[](std::size_t index) const { return const_reference(data_[index], links_[index]); }
+};
+}  // namespace detail
+
+/**
+ * @brief Tree representation where each node has a unique integer.
+ *
+ * `tree[index]` gives access to the node data (`data`) and links (`parent`, `left`, `right`, `first_child`, ...).
+ * With the StructureOfArrays layout it returns a lightweight proxy; bind it with `auto&&` rather than `auto&`.
+ *
+ * @tparam T type for node data
+ * @tparam Layout ArrayOfStructures or StructureOfArrays
+ * @tparam Index integer type for node indices; a narrower type shrinks the links, a wider one allows more nodes
+ */
+template <typename T, typename Layout = ArrayOfStructures, typename Index = int>
+class IntRootedForest {
+ public:
+  typedef Index index_type;
+  static Index const NOT_AVAILABLE = static_cast<Index>(detail::NOT_AVAILABLE);
+
+ private:
+  typedef detail::ForestStorage<T, Layout, Index> Storage;
+
+  Storage nodes_;
+  Index free_head_;  // oldest removed index; removed nodes are chained by their `right` links
+  Index free_tail_;  // newest removed index
   std::size_t num_live_nodes_;
 
+  detail::NodeLinks<Index>& link(Index index) { return nodes_.links(index); }
+  detail::NodeLinks<Index> const& link(Index index) const { return nodes_.links(index); }
+
  public:
-  IntRootedForest() : nodes_(), removed_(), num_live_nodes_(0) {}
+  IntRootedForest() : nodes_(), free_head_(NOT_AVAILABLE), free_tail_(NOT_AVAILABLE), num_live_nodes_(0) {}
+  IntRootedForest(IntRootedForest const& other) = default;
+  IntRootedForest& operator=(IntRootedForest const& other) = default;
 
   /**
-   * @brief Copy constructor
+   * @brief Takes over the storage of the given forest, leaving it empty.
    */
-  IntRootedForest(IntRootedForest const& tree) {
-    num_live_nodes_ = tree.num_live_nodes_;
-    for (int i = 0; i < static_cast<int>(tree.capacity()); ++i) {
-      nodes_.push_back(tree.nodes_[i]);
-      if (!tree.nodes_[i].alive) removed_.push(i);
+  IntRootedForest(IntRootedForest&& other) noexcept
+      : nodes_(std::move(other.nodes_)),
+        free_head_(other.free_head_),
+        free_tail_(other.free_tail_),
+        num_live_nodes_(other.num_live_nodes_) {
+    other.clear();
+  }
+
+  IntRootedForest& operator=(IntRootedForest&& other) noexcept {
+    if (this != &other) {
+      nodes_ = std::move(other.nodes_);
+      free_head_ = other.free_head_;
+      free_tail_ = other.free_tail_;
+      num_live_nodes_ = other.num_live_nodes_;
+      other.clear();
     }
+    return *this;
   }
 
   //================================================================================
   //    Node Access
   //================================================================================
   // array subscript operator for writing
-  Node& operator[](std::size_t index) {
+  typename Storage::reference operator[](std::size_t index) {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("invalid index"));
     return nodes_[index];
   }
 
   // array subscript operator for reading
-  Node const& operator[](std::size_t index) const {
+  typename Storage::const_reference operator[](std::size_t index) const {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("invalid index"));
     return nodes_[index];
   }
 
   // get nodes in the one-level lower
-  std::vector<int> get_children(int index) const {
+  std::vector<Index> get_children(Index index) const {
+    std::vector<Index> ret;
+    get_children(index, ret);
+    return ret;
+  }
+
+  /**
+   * @brief Stores the children of the given node to `out`, reusing its capacity.
+   */
+  void get_children(Index index, std::vector<Index>& out) const {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("get_children: invalid index"));
 
-    std::vector<int> ret;
-    FOR_EACH_CHILD(c, index) ret.push_back(c);
-    return ret;
+    out.clear();
+    FOR_EACH_CHILD(c, index) out.push_back(c);
+  }
+
+  //================================================================================
+  //    Lazy Traversal
+  //================================================================================
+ private:
+  // last child of the given node; the node must have a child
+  Index last_child(Index index) const {
+    auto c = link(index).first_child;
+    while (link(c).right != NOT_AVAILABLE) c = link(c).right;
+    return c;
+  }
+
+  // rightmost leaf of the given subtree
+  Index rightmost_leaf(Index index) const {
+    while (link(index).has_child()) index = last_child(index);
+    return index;
+  }
+
+  struct ChildStep {
+    static Index first(IntRootedForest const& t, Index root) { return t.link(root).first_child; }
+    static Index next(IntRootedForest const& t, Index, Index x) { return t.link(x).right; }
+  };
+
+  struct PreorderStep {
+    static Index first(IntRootedForest const&, Index root) { return root; }
+    static Index next(IntRootedForest const& t, Index root, Index x) {
+      if (t.link(x).has_child()) return t.last_child(x);
+      for (; x != root; x = t.link(x).parent) {
+        if (t.link(x).left != NOT_AVAILABLE) return t.link(x).left;
+      }
+      return NOT_AVAILABLE;
+    }
+  };
+
+  struct LeafStep {
+    static Index first(IntRootedForest const& t, Index root) { return t.rightmost_leaf(root); }
+    static Index next(IntRootedForest const& t, Index root, Index x) {
+      for (; x != root; x = t.link(x).parent) {
+        if (t.link(x).left != NOT_AVAILABLE) return t.rightmost_leaf(t.link(x).left);
+      }
+      return NOT_AVAILABLE;
+    }
+  };
+
+  struct AncestorStep {
+    static Index first(IntRootedForest const& t, Index root) { return t.link(root).parent; }
+    static Index next(IntRootedForest const& t, Index, Index x) { return t.link(x).parent; }
+  };
+
+ public:
+  /**
+   * @brief Sequence of node indices computed on the fly by following the links, without allocation.
+   *
+   * The tree structure must not be modified during iteration; node data may be.
+   */
+  template <typename Step>
+  class NodeRange {
+   private:
+    IntRootedForest const* tree_;
+    Index root_;
+
+   public:
+    class iterator {
+     private:
+      IntRootedForest const* tree_;
+      Index root_;
+      Index current_;
+
+     public:
+      iterator(IntRootedForest const* tree, Index root, Index current) : tree_(tree), root_(root), current_(current) {}
+
+      Index operator*() const { return current_; }
+      iterator& operator++() {
+        current_ = Step::next(*tree_, root_, current_);
+        return *this;
+      }
+      bool operator==(iterator const& other) const { return current_ == other.current_; }
+      bool operator!=(iterator const& other) const { return current_ != other.current_; }
+    };
+
+    NodeRange(IntRootedForest const* tree, Index root) : tree_(tree), root_(root) {}
+
+    iterator begin() const { return iterator(tree_, root_, Step::first(*tree_, root_)); }
+    iterator end() const { return iterator(tree_, root_, NOT_AVAILABLE); }
+  };
+
+  /**
+   * @brief Children of the given node, from the left to the right.
+   */
+  NodeRange<ChildStep> children(Index index) const {
+    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("children: invalid index"));
+    return NodeRange<ChildStep>(this, index);
+  }
+
+  /**
+   * @brief Nodes of the given subtree in the same order as dfs_reverse_preorder_nodes().
+   */
+  NodeRange<PreorderStep> dfs_reverse_preorder(Index index) const {
+    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("dfs_reverse_preorder: invalid index"));
+    return NodeRange<PreorderStep>(this, index);
+  }
+
+  /**
+   * @brief Leaves of the given subtree in the same order as get_leaves().
+   */
+  NodeRange<LeafStep> leaves(Index index) const {
+    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("leaves: invalid index"));
+    return NodeRange<LeafStep>(this, index);
+  }
+
+  /**
+   * @brief Proper ancestors of the given node, from the parent to the root.
+   */
+  NodeRange<AncestorStep> ancestors(Index index) const {
+    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("ancestors: invalid index"));
+    return NodeRange<AncestorStep>(this, index);
   }
 
   //================================================================================
@@ -143,14 +393,14 @@ class IntRootedForest {
    *        in a depth-first-search (left to right) pre-ordering starting at index.
    *
    * @param index start node
-   * @return std::vector<std::pair<int, int>> list of [node, entering (true) or leaving (false)]
+   * @return std::vector<std::pair<Index, int>> list of [node, entering (true) or leaving (false)]
    *         entering: traverse from parent to node
    *         leaving:  traverse from node to parent
    */
-  std::vector<std::pair<int, int>> dfs_preorder_edges(int index) const {
+  std::vector<std::pair<Index, int>> dfs_preorder_edges(Index index) const {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("dfs_preorder_edges: invalid index"));
 
-    std::vector<std::pair<int, int>> ret, stack;
+    std::vector<std::pair<Index, int>> ret, stack;
     stack.push_back({index, false});
     stack.push_back({index, true});
 
@@ -168,10 +418,10 @@ class IntRootedForest {
     return ret;
   }
 
-  std::vector<std::pair<int, int>> dfs_reverse_preorder_edges(int index) const {
+  std::vector<std::pair<Index, int>> dfs_reverse_preorder_edges(Index index) const {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("dfs_preorder_edges: invalid index"));
 
-    std::vector<std::pair<int, int>> ret, stack;
+    std::vector<std::pair<Index, int>> ret, stack;
     stack.push_back({index, false});
     stack.push_back({index, true});
 
@@ -189,26 +439,30 @@ class IntRootedForest {
     return ret;
   }
 
-  std::vector<int> bfs_nodes(int index) const {
-    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("bfs_nodes: invalid index"));
+  std::vector<Index> bfs_nodes(Index index) const {
+    std::vector<Index> ret;
+    bfs_nodes(index, ret);
+    return ret;
+  }
 
-    std::vector<int> ret;
-    std::queue<int> q;
+  /**
+   * @brief Stores the nodes of the given subtree in breadth-first order to `out`, reusing its capacity.
+   */
+  void bfs_nodes(Index index, std::vector<Index>& out) const {
+    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("bfs_nodes: invalid index"));
 
-    q.push(index);
-    while (!q.empty()) {
-      auto x = q.front();
-      q.pop();
-      ret.push_back(x);
-      FOR_EACH_CHILD(c, x) q.push(c);
+    // `out` itself serves as the queue
+    out.clear();
+    out.push_back(index);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      FOR_EACH_CHILD(c, out[i]) out.push_back(c);
     }
-    return ret;
   }
 
-  std::vector<int> dfs_preorder_nodes(int index) const {
+  std::vector<Index> dfs_preorder_nodes(Index index) const {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("dfs_preorder_nodes: invalid index"));
 
-    std::vector<int> ret, stack;
+    std::vector<Index> ret, stack;
     stack.push_back(index);
 
     while (!stack.empty()) {
@@ -222,51 +476,53 @@ class IntRootedForest {
     return ret;
   }
 
-  std::vector<int> dfs_reverse_preorder_nodes(int index) const {
-    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("dfs_reverse_preorder_nodes: invalid index"));
-
-    std::vector<int> ret, stack;
-    stack.push_back(index);
-
-    while (!stack.empty()) {
-      auto x = stack.back();
-      stack.pop_back();
-      ret.push_back(x);
-
-      FOR_EACH_CHILD(c, x) stack.push_back(c);
-    }
+  std::vector<Index> dfs_reverse_preorder_nodes(Index index) const {
+    std::vector<Index> ret;
+    dfs_reverse_preorder_nodes(index, ret);
     return ret;
   }
 
+  /**
+   * @brief Stores the nodes of the given subtree in reverse pre-order to `out`, reusing its capacity.
+   */
+  void dfs_reverse_preorder_nodes(Index index, std::vector<Index>& out) const {
+    out.clear();
+    for (auto x : dfs_reverse_preorder(index)) out.push_back(x);
+  }
+
   /**
    * @brief Returns a list of the leaves of this subtree, from the left to the right.
    *
    * @param index
-   * @return std::vector<int>
+   * @return std::vector<Index>
    */
-  std::vector<int> get_leaves(int index) const {
-    VALIDATE(if (!is_valid(index)) throw std::invalid_argument("get_leaves: invalid index"));
-
-    std::vector<int> ret;
-    for (auto x : dfs_reverse_preorder_nodes(index)) {
-      if (nodes_[x].is_leaf()) ret.push_back(x);
-    }
+  std::vector<Index> get_leaves(Index index) const {
+    std::vector<Index> ret;
+    get_leaves(index, ret);
     return ret;
   }
 
-  std::vector<int> get_ancestors(int index) const {
+  /**
+   * @brief Stores the leaves of the given subtree to `out`, reusing its capacity.
+   */
+  void get_leaves(Index index, std::vector<Index>& out) const {
+    out.clear();
+    for (auto x : leaves(index)) out.push_back(x);
+  }
+
+  std::vector<Index> get_ancestors(Index index) const {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("get_ancestors: invalid index"));
 
-    std::vector<int> ret;
-    for (auto p = nodes_[index].parent; p != NOT_AVAILABLE; p = nodes_[p].parent) ret.push_back(p);
+    std::vector<Index> ret;
+    for (auto p : ancestors(index)) ret.push_back(p);
     return ret;
   }
 
-  int get_root(int index) const {
+  Index get_root(Index index) const {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("get_root: invalid index"));
 
-    int ret = NOT_AVAILABLE;
-    for (auto p = index; p != NOT_AVAILABLE; p = nodes_[p].parent) ret = p;
+    Index ret = NOT_AVAILABLE;
+    for (auto p = index; p != NOT_AVAILABLE; p = link(p).parent) ret = p;
     return ret;
   }
 
@@ -275,77 +531,166 @@ class IntRootedForest {
   //================================================================================
   std::size_t size() const { return num_live_nodes_; }
   std::size_t capacity() const { return nodes_.size(); }
-  bool is_valid(int index) const {
-    return 0 <= index && index < static_cast<int>(capacity()) && nodes_[index].is_alive();
+  bool is_valid(Index index) const {
+    return 0 <= index && index < static_cast<Index>(capacity()) && link(index).is_alive();
   }
 
   //================================================================================
   //    Node Addition and Removal
   //================================================================================
-  int create_node() { return create_node_impl(T()); }
+  Index create_node() { return create_node_impl(T()); }
+
+  /**
+   * @brief Removes all nodes, keeping the allocated storage for reuse.
+   */
+  void clear() {
+    nodes_.clear();
+    free_head_ = free_tail_ = NOT_AVAILABLE;
+    num_live_nodes_ = 0;
+  }
 
   template <typename A>
-  int create_node(A const& arg) {
+  Index create_node(A const& arg) {
     return create_node_impl(T(arg));
   }
 
  private:
-  std::size_t create_node_impl(T const& x) {
-    int index = NOT_AVAILABLE;
+  Index create_node_impl(T const& x) {
+    Index index = NOT_AVAILABLE;
 
-    if (removed_.empty()) {
-      // add new slot
+    if (free_head_ == NOT_AVAILABLE) {
+      // add new slot; the largest value of an unsigned index type is reserved for NOT_AVAILABLE
+      if (nodes_.size() >= static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+        throw std::length_error("create_node: too many nodes for the index type");
+      }
       index = nodes_.size();
       nodes_.push_back(x);
     } else {
       // reuse removed slot
-      index = removed_.front();
-      removed_.pop();
-      if (nodes_[index].is_alive()) throw std::runtime_error("create_node_impl: reusing live node");
-      nodes_[index] = Node(x);
+      index = free_head_;
+      free_head_ = link(index).right;
+      if (free_head_ == NOT_AVAILABLE) free_tail_ = NOT_AVAILABLE;
+      if (link(index).is_alive()) throw std::runtime_error("create_node_impl: reusing live node");
+      nodes_.reset(index, x);
     }
     ++num_live_nodes_;
     return index;
   }
 
  public:
-  std::vector<int> get_roots() const {
-    std::vector<int> ret;
-    for (int i = 0; i < static_cast<int>(nodes_.size()); ++i) {
-      if (nodes_[i].alive && nodes_[i].is_root()) ret.push_back(i);
+  std::vector<Index> get_roots() const {
+    std::vector<Index> ret;
+    for (Index i = 0; i < static_cast<Index>(nodes_.size()); ++i) {
+      if (link(i).alive && link(i).is_root()) ret.push_back(i);
     }
     return ret;
   }
 
-  void remove(int index) {
+  void remove(Index index) {
     VALIDATE(if (!is_valid(index)) throw std::invalid_argument("remove: invalid index"));
     detach(index);
-    VALIDATE(if (!nodes_[index].is_leaf()) throw std::invalid_argument("remove: must be a leaf"));
+    VALIDATE(if (!link(index).is_leaf()) throw std::invalid_argument("remove: must be a leaf"));
 
     --num_live_nodes_;
-    nodes_[index].alive = false;
-    removed_.push(index);
+    link(index).alive = false;
+
+    // append to the free list (detach() has cleared the `right` link)
+    if (free_tail_ == NOT_AVAILABLE) {
+      free_head_ = index;
+    } else {
+      link(free_tail_).right = index;
+    }
+    free_tail_ = index;
+  }
+
+  /**
+   * @brief Renumbers the live nodes so that they occupy `[0, size())` in DFS order and releases the removed slots.
+   *
+   * Nodes `[0, num_fixed)` keep their indices; the other live nodes follow them in the preorder (left-to-right)
+   * of the trees, taken in the order of their root indices.
+   * Node data is moved along with the links; any external reference to a node must be translated by the result.
+   *
+   * @param num_fixed number of leading nodes to keep in place; they must be alive
+   * @return mapping from old indices to new indices; NOT_AVAILABLE for removed nodes
+   */
+  std::vector<Index> compact(Index num_fixed = 0) {
+    Index cap = capacity();
+    if (num_fixed < 0 || num_fixed > cap) throw std::invalid_argument("compact: invalid num_fixed");
+    for (Index i = 0; i < num_fixed; ++i) {
+      if (!link(i).is_alive()) throw std::invalid_argument("compact: fixed nodes must be alive");
+    }
+
+    // assign new indices
+    std::vector<Index> mapping(cap, NOT_AVAILABLE);
+    for (Index i = 0; i < num_fixed; ++i) mapping[i] = i;
+    Index next = num_fixed;
+    for (Index r = 0; r < cap; ++r) {
+      if (!link(r).is_alive() || !link(r).is_root()) continue;
+      for (auto x = r; x != NOT_AVAILABLE; x = next_preorder(r, x)) {
+        if (x >= num_fixed) mapping[x] = next++;
+      }
+    }
+
+    // translate the links
+    auto translate = [&mapping](Index& x) {
+      if (x != NOT_AVAILABLE) x = mapping[x];
+    };
+    for (Index i = 0; i < cap; ++i) {
+      if (!link(i).is_alive()) continue;
+      auto& nd = link(i);
+      translate(nd.parent);
+      translate(nd.left);
+      translate(nd.right);
+      translate(nd.first_child);
+    }
+
+    // move the nodes in place by following the cycles of the permutation; removed nodes go to the end
+    std::vector<Index> perm(mapping);
+    for (Index i = 0; i < cap; ++i) {
+      if (perm[i] == NOT_AVAILABLE) perm[i] = next++;
+    }
+    for (Index i = 0; i < cap; ++i) {
+      while (perm[i] != i) {
+        Index j = perm[i];
+        nodes_.swap(i, j);
+        std::swap(perm[i], perm[j]);
+      }
+    }
+
+    nodes_.truncate(num_live_nodes_);
+    free_head_ = free_tail_ = NOT_AVAILABLE;
+    return mapping;
+  }
+
+ private:
+  // next node of the left-to-right preorder traversal of the tree rooted at `root`
+  Index next_preorder(Index root, Index x) const {
+    if (link(x).has_child()) return link(x).first_child;
+    for (; x != root; x = link(x).parent) {
+      if (link(x).right != NOT_AVAILABLE) return link(x).right;
+    }
+    return NOT_AVAILABLE;
   }
 
   //================================================================================
   //    Modification
   //================================================================================
  private:
-  void add_child(int parent, int child) {
+  void add_child(Index parent, Index child) {
     VALIDATE({
       if (!is_valid(parent)) throw std::invalid_argument("add_child: parent invalid index");
       if (!is_valid(child)) throw std::invalid_argument("add_child: child invalid index");
     });
-    auto& p = nodes_[parent];
-    auto& c = nodes_[child];
+    auto& p = link(parent);
+    auto& c = link(child);
 
     VALIDATE({
       if (!c.is_root()) throw std::invalid_argument("add_child: child must be a root");
     });
 
     if (p.has_child()) {
-      nodes_[p.first_child].left = child;
-      nodes_[child].right = p.first_child;
+      link(p.first_child).left = child;
+      link(child).right = p.first_child;
     }
 
     p.first_child = child;
@@ -354,23 +699,23 @@ class IntRootedForest {
   }
 
  public:
-  void detach(int index) {
+  void detach(Index index) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("detach: invalid index");
     });
 
-    auto& node = nodes_[index];
-    if (node.parent != NOT_AVAILABLE) nodes_[node.parent].num_children--;
-    if (node.is_first_child()) nodes_[node.parent].first_child = node.right;
-    if (node.left != NOT_AVAILABLE) nodes_[node.left].right = node.right;
-    if (node.right != NOT_AVAILABLE) nodes_[node.right].left = node.left;
+    auto& node = link(index);
+    if (node.parent != NOT_AVAILABLE) link(node.parent).num_children--;
+    if (node.is_first_child()) link(node.parent).first_child = node.right;
+    if (node.left != NOT_AVAILABLE) link(node.left).right = node.right;
+    if (node.right != NOT_AVAILABLE) link(node.right).left = node.left;
 
     node.parent = NOT_AVAILABLE;
     node.left = NOT_AVAILABLE;
     node.right = NOT_AVAILABLE;
   };
 
-  void swap(int a, int b) {
+  void swap(Index a, Index b) {
     VALIDATE({
       if (!is_valid(a)) throw std::invalid_argument("swap: a invalid index");
       if (!is_valid(b)) throw std::invalid_argument("swap: b invalid index");
@@ -378,20 +723,20 @@ class IntRootedForest {
     });
     // if (a == b) return; // never happens
 
-    auto& na = nodes_[a];
-    auto& nb = nodes_[b];
+    auto& na = link(a);
+    auto& nb = link(b);
 
-    if (na.is_first_child()) nodes_[na.parent].first_child = b;
-    if (na.left != NOT_AVAILABLE) nodes_[na.left].right = b;
-    if (na.right != NOT_AVAILABLE) nodes_[na.right].left = b;
+    if (na.is_first_child()) link(na.parent).first_child = b;
+    if (na.left != NOT_AVAILABLE) link(na.left).right = b;
+    if (na.right != NOT_AVAILABLE) link(na.right).left = b;
 
-    if (nb.is_first_child()) nodes_[nb.parent].first_child = a;
-    if (nb.left != NOT_AVAILABLE) nodes_[nb.left].right = a;
-    if (nb.right != NOT_AVAILABLE) nodes_[nb.right].left = a;
+    if (nb.is_first_child()) link(nb.parent).first_child = a;
+    if (nb.left != NOT_AVAILABLE) link(nb.left).right = a;
+    if (nb.right != NOT_AVAILABLE) link(nb.right).left = a;
 
-    std::swap(nodes_[a].parent, nodes_[b].parent);
-    std::swap(nodes_[a].left, nodes_[b].left);
-    std::swap(nodes_[a].right, nodes_[b].right);
+    std::swap(link(a).parent, link(b).parent);
+    std::swap(link(a).left, link(b).left);
+    std::swap(link(a).right, link(b).right);
   }
 
   /**
@@ -399,7 +744,7 @@ class IntRootedForest {
    * @param index node to be replaced
    * @param replace_by not to replace
    */
-  void replace(int index, int replace_by) {
+  void replace(Index index, Index replace_by) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("replace: invalid index");
       if (!is_valid(replace_by)) throw std::invalid_argument("replace: replace_by invalid index");
@@ -413,7 +758,7 @@ class IntRootedForest {
     swap(index, replace_by);
   }
 
-  void move_to(int index, int new_parent) {
+  void move_to(Index index, Index new_parent) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("move_to: invalid index");
       if (!is_valid(new_parent)) throw std::invalid_argument("move_to: new_parent invalid index");
@@ -428,11 +773,11 @@ class IntRootedForest {
    * @brief Moves this node to the left sibling of the given node.
    * @param node node that is not a root
    */
-  void move_to_before(int index, int target) {
+  void move_to_before(Index index, Index target) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("move_to_after: invalid index");
       if (!is_valid(target)) throw std::invalid_argument("move_to_after: target invalid index");
-      if (nodes_[target].is_root()) throw std::invalid_argument("move_to_before: target must not be a root");
+      if (link(target).is_root()) throw std::invalid_argument("move_to_before: target must not be a root");
       if (index == target) throw std::invalid_argument("move_to_after: index and target cannot be the same");
       if (util::contains(get_ancestors(target), index)) {
         throw std::invalid_argument("replace: index cannot be an ancestor of target");
@@ -441,16 +786,16 @@ class IntRootedForest {
 
     detach(index);
 
-    auto& x = nodes_[index];
-    auto& y = nodes_[target];
+    auto& x = link(index);
+    auto& y = link(target);
 
     x.parent = y.parent;
     x.left = y.left;
     x.right = target;
 
-    nodes_[y.parent].num_children++;
-    if (y.is_first_child()) nodes_[y.parent].first_child = index;
-    if (!y.is_first_child()) nodes_[y.left].right = index;
+    link(y.parent).num_children++;
+    if (y.is_first_child()) link(y.parent).first_child = index;
+    if (!y.is_first_child()) link(y.left).right = index;
     y.left = index;
   }
 
@@ -458,11 +803,11 @@ class IntRootedForest {
    * @brief Moves this node to the right sibling of the given node.
    * @param node node that is not a root
    */
-  void move_to_after(int index, int target) {
+  void move_to_after(Index index, Index target) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("move_to_after: invalid index");
       if (!is_valid(target)) throw std::invalid_argument("move_to_after: target invalid index");
-      if (nodes_[target].is_root()) throw std::invalid_argument("move_to_after: target must not be a root");
+      if (link(target).is_root()) throw std::invalid_argument("move_to_after: target must not be a root");
       if (index == target) throw std::invalid_argument("move_to_after: index and target cannot be the same");
       if (util::contains(get_ancestors(target), index)) {
         throw std::invalid_argument("move_to_after: index cannot be an ancestor of target");
@@ -471,36 +816,36 @@ class IntRootedForest {
 
     detach(index);
 
-    auto& x = nodes_[index];
-    auto& y = nodes_[target];
+    auto& x = link(index);
+    auto& y = link(target);
 
     x.parent = y.parent;
     x.left = target;
     x.right = y.right;
 
-    nodes_[y.parent].num_children++;
-    if (y.right != NOT_AVAILABLE) nodes_[y.right].left = index;
+    link(y.parent).num_children++;
+    if (y.right != NOT_AVAILABLE) link(y.right).left = index;
     y.right = index;
   }
 
   /**
    * @brief Moves this node to the first among all its siblings.
    */
-  void make_first_child(int index) {
+  void make_first_child(Index index) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("make_first_child: invalid index");
     });
 
-    if (nodes_[index].is_root() || nodes_[index].is_first_child()) return;  // do nothing
+    if (link(index).is_root() || link(index).is_first_child()) return;  // do nothing
 
-    move_to_before(index, nodes_[nodes_[index].parent].first_child);
+    move_to_before(index, link(link(index).parent).first_child);
   }
 
   /**
    * @brief Moves all the children of the given node to this node.
    * @param node node whose children are to be added to this node's children
    */
-  void add_children_from(int index, int target) {
+  void add_children_from(Index index, Index target) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("add_children_from: invalid index");
       if (!is_valid(target)) throw std::invalid_argument("add_children_from: target invalid index");
@@ -511,14 +856,14 @@ class IntRootedForest {
 
     if (index == target) return;  // do nothing
 
-    auto& node = nodes_[index];
-    auto& t = nodes_[target];
+    auto& node = link(index);
+    auto& t = link(target);
 
     FOR_EACH_CHILD(c, target) {
-      nodes_[c].parent = index;
-      if (nodes_[c].is_last_child()) {
-        nodes_[c].right = node.first_child;
-        if (node.has_child()) nodes_[node.first_child].left = c;
+      link(c).parent = index;
+      if (link(c).is_last_child()) {
+        link(c).right = node.first_child;
+        if (node.has_child()) link(node.first_child).left = c;
         break;  // necessary; otherwise it may not stop
       }
     }
@@ -533,15 +878,15 @@ class IntRootedForest {
    * @brief Replaces the given node by its own children.
    * This original node will be detached form its tree but not removed.
    */
-  void replace_by_children(int index) {
+  void replace_by_children(Index index) {
     VALIDATE({
       if (!is_valid(index)) throw std::invalid_argument("replace_by_children: invalid index");
-      auto& node = nodes_[index];
+      auto& node = link(index);
       if (node.is_root()) throw std::invalid_argument("replace_by_children:this must not be a root");
     });
 
-    for (auto c = nodes_[index].first_child; c != NOT_AVAILABLE;) {
-      auto nxt = nodes_[c].right;
+    for (auto c = link(index).first_child; c != NOT_AVAILABLE;) {
+      auto nxt = link(c).right;
       move_to_before(c, index);
       c = nxt;
     }
@@ -554,7 +899,7 @@ class IntRootedForest {
    * @param index
    * @param target cannot be the same as index
    */
-  void replace_children(int index, int target) {
+  void replace_children(Index index, Index target) {
     for (auto c : get_children(index)) detach(c);
     move_to(target, index);
   }
@@ -562,7 +907,18 @@ class IntRootedForest {
   //================================================================================
   //    I/O
   //================================================================================
-  std::string to_string(int root) const {
+  std::string to_string(Index root) const {
+    return to_string(root, [](std::ostream &os, T const &data) { os << data; });
+  }
+
+  /**
+   * @brief Returns the string representation of the subtree with a custom printer for node data.
+   *
+   * @param root root of the subtree
+   * @param print function that writes the given data to the given stream
+   */
+  template <typename Print>
+  std::string to_string(Index root, Print print) const {
     std::stringstream ss;
     if (!is_valid(root)) {
       ss << "invalid(" << root << ")";
@@ -570,28 +926,29 @@ class IntRootedForest {
     }
 
     // DFS without recursive calls
-    std::stack<int> stack;
-    std::unordered_set<int> visited;
+    std::stack<Index> stack;
+    std::unordered_set<Index> visited;
 
-    stack.push(-1);
+    stack.push(NOT_AVAILABLE);
     stack.push(root);
 
     while (!stack.empty()) {
       auto p = stack.top();
       stack.pop();
 
-      if (p != -1) {
+      if (p != NOT_AVAILABLE) {
         if (visited.find(p) != visited.end()) {
           // found a cycle
           return "cycle detected";
         }
         visited.insert(p);
-        ss << "(" << nodes_[p].data;
+        ss << "(";
+        print(ss, nodes_.data(p));
 
         auto st = get_children(p);
         // add to the stack in reverse ordering
         for (auto it = st.rbegin(); it != st.rend(); ++it) {
-          stack.push(-1);
+          stack.push(NOT_AVAILABLE);
           stack.push(*it);
         }
       } else {
@@ -610,31 +967,34 @@ class IntRootedForest {
    *
    */
   void check_consistency() const {
-    int num_alive = 0;
-    for (int i = 0; i < static_cast<int>(capacity()); ++i) {
-      if (!nodes_[i].is_alive()) continue;
+    std::size_t num_alive = 0;
+    for (Index i = 0; i < static_cast<Index>(capacity()); ++i) {
+      if (!link(i).is_alive()) continue;
       ++num_alive;
       // left & right connections
-      if (nodes_[i].left != NOT_AVAILABLE && nodes_[nodes_[i].left].right != i) {
+      if (link(i).left != NOT_AVAILABLE && link(link(i).left).right != i) {
         throw std::runtime_error("left->right must be this");
       }
-      if (nodes_[i].right != NOT_AVAILABLE && nodes_[nodes_[i].right].left != i) {
+      if (link(i).right != NOT_AVAILABLE && link(link(i).right).left != i) {
         throw std::runtime_error("right->left must be this");
       }
       // children
-      if (static_cast<int>(get_children(i).size()) != nodes_[i].number_of_children()) {
+      if (static_cast<Index>(get_children(i).size()) != link(i).number_of_children()) {
         throw std::runtime_error("number of children does not match");
       }
       // parent
-      if (nodes_[i].parent != NOT_AVAILABLE) {
-        auto cs = get_children(nodes_[i].parent);
+      if (link(i).parent != NOT_AVAILABLE) {
+        auto cs = get_children(link(i).parent);
         if (!util::contains(cs, i)) throw std::runtime_error("parent must have this as a child");
       }
     }
-    if (num_alive != static_cast<int>(size())) throw std::runtime_error("number of active nodes does not match");
+    if (num_alive != size()) throw std::runtime_error("number of active nodes does not match");
   }
 
  private:
 };
+
+template <typename T, typename Layout, typename Index>
+Index const IntRootedForest<T, Layout, Index>::NOT_AVAILABLE;
 }  // namespace tree
 }  // namespace ds
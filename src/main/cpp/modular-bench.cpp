@@ -1,27 +1,92 @@
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include "modular/MDTree.hpp"
+#include "readwrite/batch.hpp"
 #include "readwrite/edge_list.hpp"
+#include "readwrite/load_graph.hpp"
 
 using namespace std;
 
+namespace {
+/**
+ * @brief Decomposes every graph in the batch and prints `<modular width> <tree>` per graph in input order,
+ * followed by the total time in seconds on stderr.
+ */
+void run_batch(readwrite::GraphBatch const& batch, bool relabel, int num_threads) {
+  vector<vector<int64_t>> labels(batch.size());
+
+  auto time_start = chrono::system_clock::now();
+  modular::decompose_batch(
+      batch.size(), [&](size_t i) { return batch.load(i, relabel ? &labels[i] : nullptr); },
+      [&](size_t i, modular::MDTree&& tree) {
+        printf("%d %s\n", tree.modular_width(), tree.to_string(labels[i]).c_str());
+        vector<int64_t>().swap(labels[i]);
+      },
+      true, num_threads);
+  auto elapsed = chrono::system_clock::now() - time_start;
+  fprintf(stderr, "%.10f\n", chrono::duration_cast<chrono::nanoseconds>(elapsed).count() * 1e-9);
+}
+}  // namespace
+
 int main(int argc, char* argv[]) {
-  // load graph
-  auto graph = readwrite::read_edge_list(std::cin);
+  // --relabel: compact sparse vertex labels and print the tree with the original labels
+  // --batch: decompose a directory of graphs, a concatenation of binary graphs,
+  //          or edge lists separated by blank lines (from the given path or stdin)
+  // --threads N: number of threads for reading and solving; 0 means all hardware threads (default: 1)
+  bool relabel = false, batch = false;
+  int num_threads = 1;
+  char const* path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--relabel") == 0) {
+      relabel = true;
+    } else if (strcmp(argv[i], "--batch") == 0) {
+      batch = true;
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      char* end = nullptr;
+      long x = i + 1 < argc ? strtol(argv[i + 1], &end, 10) : -1;
+      if (x < 0 || x > INT_MAX || end == argv[i + 1] || *end) {
+        fprintf(stderr, "--threads: expected a non-negative integer\n");
+        return 1;
+      }
+      num_threads = static_cast<int>(x);
+      ++i;
+    } else {
+      path = argv[i];
+    }
+  }
+
+  if (batch) {
+    if (path) {
+      run_batch(readwrite::GraphBatch(path), relabel, num_threads);
+    } else {
+      run_batch(readwrite::GraphBatch(std::cin), relabel, num_threads);
+    }
+    return 0;
+  }
+
+  // load graph from the given path, or from stdin
+  vector<int64_t> labels;
+  auto graph = path ? readwrite::load_graph(path, num_threads, relabel ? &labels : nullptr)
+               : relabel ? readwrite::read_edge_list_relabeled(std::cin, labels, num_threads)
+                         : readwrite::read_edge_list_csr(std::cin, num_threads);
 
-  // run algorithm
+  // run algorithm; profiling requires a single thread
 #if PROFILE_ON
   util::Profiler prof;
-  auto result = modular::modular_decomposition_time(graph, true, &prof);
+  auto result = modular::modular_decomposition_time(graph, true, &prof, num_threads);
   prof.print();
 #else
-  auto result = modular::modular_decomposition_time(graph, true);
+  auto result = modular::modular_decomposition_time(graph, true, nullptr, num_threads);
 #endif
 
   // output result
   printf("%d\n", result.first.modular_width());
   printf("%.10f\n", result.second);
-  printf("%s\n", result.first.to_string().c_str());
+  printf("%s\n", result.first.to_string(labels).c_str());
 
   return 0;
 }
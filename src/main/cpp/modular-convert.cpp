@@ -0,0 +1,28 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "readwrite/binary.hpp"
+#include "readwrite/load_graph.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+  // --relabel: compact sparse vertex labels of an edge list and store the original labels
+  bool relabel = argc > 1 && strcmp(argv[1], "--relabel") == 0;
+  if (argc != 3 + relabel) {
+    fprintf(stderr, "Usage: %s [--relabel] <input graph> <output binary graph>\n", argv[0]);
+    return 1;
+  }
+
+  try {
+    vector<int64_t> labels;
+    auto graph = readwrite::load_graph(argv[1 + relabel], 0, relabel ? &labels : nullptr);
+    readwrite::save_binary_graph(argv[2 + relabel], graph, labels.empty() ? nullptr : &labels);
+    fprintf(stderr, "n=%zu, m=%zu\n", graph.number_of_nodes(), graph.number_of_edges());
+  } catch (std::exception const& e) {
+    fprintf(stderr, "Error: %s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
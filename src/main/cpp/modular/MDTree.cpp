@@ -1,21 +1,374 @@
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
 
 #include "MDTree.hpp"
+#include "util/parallel.hpp"
 
 namespace modular {
 
 std::ostream &operator<<(std::ostream &os, MDNode const &node) { return os << node.to_string(); }
 
+MDTree::MDTree(MDPart const &part) : root_(-1) {
+  std::vector<int> bases;
+  add_vertex_nodes(part, bases);
+  if (vertices_.empty()) return;
+
+  int leaf = 0;
+  root_ = add_internal_nodes(part, 0, bases, leaf);
+}
+
+void MDTree::add_vertex_nodes(MDPart const &part, std::vector<int> &bases) {
+  if (!part.children.empty()) {
+    for (auto &c : part.children) add_vertex_nodes(*c, bases);
+    return;
+  }
+
+  int offset = vertices_.size();
+  bases.push_back(tree_.capacity());
+  if (part.vertices.size() == 1) {
+    vertices_.push_back(part.vertices[0]);
+    tree_.create_node(MDNode(part.vertices[0], Operation::PRIME, offset, offset + 1));
+    return;
+  }
+
+  // vertex nodes of a decomposition have the smallest indices in its tree
+  auto &t = part.tree;
+  if (t.vertices_.size() != part.vertices.size()) throw std::invalid_argument("MDTree: part size mismatch");
+  for (auto v : t.vertices_) vertices_.push_back(part.vertices[v]);
+  for (std::size_t x = 0; x < t.vertices_.size(); ++x) {
+    auto const &data = t.tree_[x].data;
+    tree_.create_node(
+        MDNode(part.vertices[data.vertex], Operation::PRIME, offset + data.vertices_begin, offset + data.vertices_end));
+  }
+}
+
+int MDTree::add_internal_nodes(MDPart const &part, int offset, std::vector<int> const &bases, int &leaf) {
+  if (!part.children.empty()) {
+    std::vector<int> roots;
+    int begin = offset;
+    for (auto &c : part.children) {
+      roots.push_back(add_internal_nodes(*c, offset, bases, leaf));
+      offset += c->vertices.size();
+    }
+    auto node_idx = tree_.create_node(MDNode(-1, part.op, begin, offset));
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) tree_.move_to(*it, node_idx);
+    return node_idx;
+  }
+
+  auto base = bases[leaf++];
+  if (part.vertices.size() == 1) return base;
+
+  // create internal nodes from the bottom, shifting the vertex ranges by the offset of the part
+  auto &t = part.tree;
+  auto const NA = ds::tree::IntRootedForest<MDNode>::NOT_AVAILABLE;
+  std::vector<int> order, mapping(t.tree_.capacity(), -1);
+  t.tree_.dfs_reverse_preorder_nodes(t.root_, order);
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    auto &&nd = t.tree_[*it];
+    if (nd.is_leaf()) {
+      mapping[*it] = base + *it;
+      continue;
+    }
+
+    auto node_idx =
+        tree_.create_node(MDNode(-1, nd.data.op, offset + nd.data.vertices_begin, offset + nd.data.vertices_end));
+    int last = nd.first_child;
+    while (t.tree_[last].right != NA) last = t.tree_[last].right;
+    for (auto c = last; c != NA; c = t.tree_[c].left) tree_.move_to(mapping[c], node_idx);
+    mapping[*it] = node_idx;
+  }
+  return mapping[t.root_];
+}
+
+namespace {
+/**
+ * @brief Groups the vertices by label in linear time.
+ *
+ * @param label label[v] is the group of vertex v, between 0 and k - 1
+ * @return vertices of each group in increasing order
+ */
+std::vector<std::vector<VertexID>> group_by_label(std::vector<int> const &label, int k) {
+  std::vector<std::vector<VertexID>> ret(k);
+  for (std::size_t v = 0; v < label.size(); ++v) ret[label[v]].push_back(v);
+  return ret;
+}
+
+/**
+ * @brief Splits the vertices into connected components.
+ *
+ * @return vertices of each component in increasing order; components are ordered by their smallest vertices
+ */
+std::vector<std::vector<VertexID>> connected_components(ds::graph::CSRGraph const &graph) {
+  int n = graph.number_of_nodes();
+  std::vector<int> label(n, -1), queue;
+  int k = 0;
+
+  for (int s = 0; s < n; ++s) {
+    if (label[s] >= 0) continue;
+    label[s] = k;
+    queue.assign(1, s);
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+      for (auto u : graph.neighbors(queue[i])) {
+        if (label[u] < 0) {
+          label[u] = k;
+          queue.push_back(u);
+        }
+      }
+    }
+    ++k;
+  }
+  return group_by_label(label, k);
+}
+
+/**
+ * @brief Splits the vertices into the connected components of the complement in linear time.
+ *
+ * Runs BFS on the complement without building it: the unvisited vertices are kept in one list,
+ * and scanning it from vertex v removes the non-neighbors of v, while each vertex kept is paid for by an edge.
+ *
+ * @return vertices of each co-component in increasing order; co-components are ordered by their smallest vertices
+ */
+std::vector<std::vector<VertexID>> co_components(ds::graph::CSRGraph const &graph) {
+  int n = graph.number_of_nodes();
+  std::vector<int> label(n), mark(n, -1), queue, rest(n), kept;
+  for (int i = 0; i < n; ++i) rest[i] = n - 1 - i;  // decreasing order; the back is the smallest
+  int k = 0;
+
+  while (!rest.empty()) {
+    queue.assign(1, rest.back());
+    rest.pop_back();
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+      auto v = queue[i];
+      label[v] = k;
+      for (auto u : graph.neighbors(v)) mark[u] = v;
+
+      kept.clear();
+      for (auto u : rest) {
+        if (mark[u] == v) {
+          kept.push_back(u);
+        } else {
+          queue.push_back(u);
+        }
+      }
+      rest.swap(kept);
+    }
+    ++k;
+  }
+  return group_by_label(label, k);
+}
+
+/**
+ * @brief Returns the subgraph induced by the given part, whose vertices are in increasing order.
+ *
+ * @param part part[v] is the index of the part containing vertex v
+ * @param local local[v] is the index of vertex v in its part
+ */
+ds::graph::CSRGraph induced_subgraph(ds::graph::CSRGraph const &graph, std::vector<VertexID> const &vertices,
+                                     std::vector<int> const &part, std::vector<int> const &local) {
+  std::vector<ds::graph::CSRGraph::offset_type> offsets(1, 0);
+  std::vector<int> targets;
+  for (auto v : vertices) {
+    for (auto u : graph.neighbors(v)) {
+      if (part[u] == part[v]) targets.push_back(local[u]);  // stays sorted
+    }
+    offsets.push_back(targets.size());
+  }
+  return ds::graph::CSRGraph(std::move(offsets), std::move(targets));
+}
+
+/**
+ * @brief Part of the graph waiting to be split or solved.
+ */
+struct PartTask {
+  MDPart *part;
+  ds::graph::CSRGraph graph;  // induced subgraph on local vertices
+  Operation parent_op;        // type of the split that made this part; PRIME for the whole graph
+};
+
+/**
+ * @brief Splits the given part into its connected components or co-components.
+ *
+ * Children of a parallel split are connected and children of a series split are co-connected,
+ * so only the other kind of split is tried on them.
+ * Below the top level, a split is taken only if every subpart has at most 7/8 of the vertices.
+ * Then the parts are nested at most O(log n) deep, each level costs O(n + m) in total,
+ * and splitting takes O((n + m) log n) time overall.
+ *
+ * @param op set to the type of the split
+ * @return subparts on local vertices; empty if the part is not split
+ */
+std::vector<std::vector<VertexID>> split(PartTask const &task, Operation &op) {
+  std::vector<std::vector<VertexID>> ret;
+  if (task.parent_op != Operation::PARALLEL) {
+    op = Operation::PARALLEL;
+    ret = connected_components(task.graph);
+  }
+  if (ret.size() <= 1 && task.parent_op != Operation::SERIES) {
+    op = Operation::SERIES;
+    ret = co_components(task.graph);
+  }
+  if (ret.size() <= 1) return {};
+
+  std::size_t n = task.graph.number_of_nodes(), largest = 0;
+  for (auto &vs : ret) largest = std::max(largest, vs.size());
+  if (task.parent_op != Operation::PRIME && 8 * largest > 7 * n) return {};
+  return ret;
+}
+}  // namespace
+
 MDTree modular_decomposition(ds::graph::Graph const &graph, bool sorted) { return MDTree(graph, sorted); }
 
+MDTree modular_decomposition(ds::graph::CSRGraph const &graph, bool sorted, int num_threads) {
+  num_threads = util::resolve_num_threads(num_threads);
+  int n = graph.number_of_nodes();
+  if (num_threads == 1 || n <= 1) return MDTree(graph, sorted);
+
+  MDPart root;
+  for (int i = 0; i < n; ++i) root.vertices.push_back(i);
+
+  std::vector<compute::SolverWorkspace> workspaces(num_threads);
+  std::vector<PartTask> tasks = {{&root, graph, Operation::PRIME}};
+  util::run_tasks(num_threads, std::move(tasks), [&](int t, PartTask &task, auto const &push) {
+    auto &part = *task.part;
+    auto subparts = split(task, part.op);
+    if (subparts.empty()) {
+      part.tree = MDTree(task.graph, workspaces[t], sorted);
+      return;
+    }
+
+    // local indices; subparts keep the relative order of vertices, so sorted subparts give a sorted tree
+    std::vector<int> index(part.vertices.size()), local(part.vertices.size());
+    for (std::size_t i = 0; i < subparts.size(); ++i) {
+      for (std::size_t j = 0; j < subparts[i].size(); ++j) {
+        index[subparts[i][j]] = i;
+        local[subparts[i][j]] = j;
+      }
+      part.children.push_back(std::make_unique<MDPart>());
+      for (auto v : subparts[i]) part.children.back()->vertices.push_back(part.vertices[v]);
+    }
+
+    // the largest subpart is pushed last and runs first
+    std::vector<int> order;
+    for (std::size_t i = 0; i < subparts.size(); ++i) {
+      if (subparts[i].size() > 1) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(),
+              [&subparts](int a, int b) { return subparts[a].size() < subparts[b].size(); });
+    for (auto i : order) {
+      push({part.children[i].get(), induced_subgraph(task.graph, subparts[i], index, local), part.op});
+    }
+  });
+
+  if (root.children.empty()) return std::move(root.tree);
+  return MDTree(root);
+}
+
 std::pair<MDTree, double> modular_decomposition_time(ds::graph::Graph const &graph, bool sorted, util::Profiler *prof) {
+  return modular_decomposition_time(ds::graph::CSRGraph(graph), sorted, prof);
+}
+
+std::pair<MDTree, double> modular_decomposition_time(ds::graph::CSRGraph const &graph, bool sorted,
+                                                     util::Profiler *prof, int num_threads) {
+  num_threads = util::resolve_num_threads(num_threads);
+  if (prof && num_threads != 1) throw std::invalid_argument("modular_decomposition_time: profiling needs one thread");
+
   auto time_start = std::chrono::system_clock::now();
-  auto ret = MDTree(graph, false, prof);
+  auto ret = num_threads == 1 ? MDTree(graph, false, prof) : modular_decomposition(graph, false, num_threads);
   auto time_finish = std::chrono::system_clock::now();
   auto elapsed = time_finish - time_start;
   auto elapsed_sec = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() * 1e-9;
 
   if (sorted) ret.sort();
-  return {ret, elapsed_sec};
+  return {std::move(ret), elapsed_sec};
+}
+
+void decompose_batch(std::size_t count, std::function<ds::graph::CSRGraph(std::size_t)> const &load,
+                     std::function<void(std::size_t, MDTree &&)> const &emit, bool sorted, int num_threads) {
+  num_threads = std::max<int>(1, std::min<std::size_t>(util::resolve_num_threads(num_threads), count));
+  std::size_t const window = 4 * num_threads;  // results held at once
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::size_t next = 0, emitted = 0;
+  std::vector<MDTree> slots(window);
+  std::vector<bool> ready(window);
+  bool emitting = false, failed = false;
+
+  auto fail = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      failed = true;
+    }
+    cv.notify_all();
+  };
+
+  // tiny graphs are solved with 16-bit indices; the tree has stayed within a few times n nodes,
+  // and a graph that still runs out of indices is solved again with int
+  std::size_t const max_narrow_nodes = 1 << 12;
+  std::vector<compute::BasicSolverWorkspace<uint16_t>> narrow_workspaces(num_threads);
+  std::vector<compute::SolverWorkspace> workspaces(num_threads);
+  auto solve = [&](ds::graph::CSRGraph const &graph, int t) {
+    if (graph.number_of_nodes() <= max_narrow_nodes) {
+      try {
+        return MDTree(graph, narrow_workspaces[t], sorted);
+      } catch (std::length_error const &) {
+      }
+    }
+    return MDTree(graph, workspaces[t], sorted);
+  };
+
+  util::parallel_for(num_threads, [&](int t) {
+    for (;;) {
+      std::size_t i;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return failed || next >= count || next < emitted + window; });
+        if (failed || next >= count) return;
+        i = next++;
+      }
+
+      MDTree tree;
+      try {
+        tree = solve(load(i), t);
+      } catch (...) {
+        fail();
+        throw;
+      }
+
+      // the thread that finds no one emitting flushes every result ready in order
+      std::unique_lock<std::mutex> lock(mutex);
+      slots[i % window] = std::move(tree);
+      ready[i % window] = true;
+      if (emitting) continue;
+
+      emitting = true;
+      while (!failed && ready[emitted % window]) {
+        auto j = emitted;
+        auto result = std::move(slots[j % window]);
+        ready[j % window] = false;
+        lock.unlock();
+        try {
+          emit(j, std::move(result));
+        } catch (...) {
+          fail();
+          throw;
+        }
+        lock.lock();
+        ++emitted;
+        cv.notify_all();
+      }
+      emitting = false;
+    }
+  });
+}
+
+std::vector<MDTree> decompose_batch(std::vector<ds::graph::CSRGraph> const &graphs, bool sorted, int num_threads) {
+  std::vector<MDTree> ret(graphs.size());
+  decompose_batch(
+      graphs.size(), [&graphs](std::size_t i) { return graphs[i]; },
+      [&ret](std::size_t i, MDTree &&tree) { ret[i] = std::move(tree); }, sorted, num_threads);
+  return ret;
 }
 }  // namespace modular
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "util/profiler.hpp"
 
 #include "compute/MDSolver.hpp"
@@ -17,14 +20,10 @@ class MDNode {
 
   MDNode(VertexID vertex = -1, Operation op = Operation::PRIME, VertexID vertices_begin = -1, VertexID vertices_end = -1)
       : op(op), vertex(vertex), vertices_begin(vertices_begin), vertices_end(vertices_end) {}
-  MDNode(MDNode const &node)
-      : op(node.op), vertex(node.vertex), vertices_begin(node.vertices_begin), vertices_end(node.vertices_end) {}
-  void operator=(MDNode const &node) {
-    vertex = node.vertex;
-    op = node.op;
-    vertices_begin = node.vertices_begin;
-    vertices_end = node.vertices_end;
-  }
+  MDNode(MDNode const &node) = default;
+  MDNode(MDNode &&node) = default;
+  MDNode &operator=(MDNode const &node) = default;
+  MDNode &operator=(MDNode &&node) = default;
 
   int size() const { return vertices_end - vertices_begin; }
   bool is_vertex_node() const { return vertex >= 0; }
@@ -41,56 +40,107 @@ class MDNode {
 
 std::ostream &operator<<(std::ostream &os, MDNode const &node);
 
+struct MDPart;
+
 class MDTree {
  private:
   ds::tree::IntRootedForest<MDNode> tree_;
   int root_;
   std::vector<VertexID> vertices_;
 
+  void add_vertex_nodes(MDPart const &part, std::vector<int> &bases);
+  int add_internal_nodes(MDPart const &part, int offset, std::vector<int> const &bases, int &leaf);
+
  public:
   MDTree() : root_(-1){};
-  MDTree(ds::graph::Graph const &graph, bool sorted = false, util::Profiler *prof = nullptr) {
-    auto result = compute::MDSolver::compute(graph, prof);
-    if (result.second >= 0) {
-      *this = MDTree(result.first, result.second);
+  MDTree(MDTree const &other) = default;
+  MDTree &operator=(MDTree const &other) = default;
+
+  /**
+   * @brief Takes over the nodes of the given tree, leaving it empty.
+   */
+  MDTree(MDTree &&other) noexcept
+      : tree_(std::move(other.tree_)), root_(other.root_), vertices_(std::move(other.vertices_)) {
+    other.root_ = -1;
+    other.vertices_.clear();
+  }
+
+  MDTree &operator=(MDTree &&other) noexcept {
+    if (this != &other) {
+      tree_ = std::move(other.tree_);
+      root_ = other.root_;
+      vertices_ = std::move(other.vertices_);
+      other.root_ = -1;
+      other.vertices_.clear();
+    }
+    return *this;
+  }
+
+  MDTree(ds::graph::Graph const &graph, bool sorted = false, util::Profiler *prof = nullptr)
+      : MDTree(ds::graph::CSRGraph(graph), sorted, prof) {}
+
+  MDTree(ds::graph::CSRGraph const &graph, bool sorted = false, util::Profiler *prof = nullptr) : root_(-1) {
+    compute::SolverWorkspace ws;
+    *this = MDTree(graph, ws, sorted, prof);
+  }
+
+  /**
+   * @brief Computes the modular decomposition reusing the buffers in the given workspace.
+   *
+   * @tparam Index index type of the computation tree; see compute::BasicSolverWorkspace
+   */
+  template <typename Index>
+  MDTree(ds::graph::CSRGraph const &graph, compute::BasicSolverWorkspace<Index> &ws, bool sorted = false,
+         util::Profiler *prof = nullptr)
+      : root_(-1) {
+    auto comp_root = compute::MDSolver::compute(graph, ws, prof);
+    if (comp_root != compute::BasicCompTree<Index>::NOT_AVAILABLE) {
+      *this = MDTree(ws.tree, comp_root);
       if (sorted) this->sort();
     }
   }
 
-  MDTree(compute::CompTree const &comp_tree, int comp_root) {
-    // get all leaves in DFS order (right-to-left)
-    vertices_ = comp_tree.get_leaves(comp_root);
-    std::reverse(vertices_.begin(), vertices_.end());  // convert to left-to-right
+  /**
+   * @brief Builds the decomposition of a graph from those of the parts it was split into.
+   */
+  explicit MDTree(MDPart const &part);
 
-    int n = vertices_.size();
+  template <typename Index>
+  MDTree(compute::BasicCompTree<Index> const &comp_tree, Index comp_root) {
+    typedef compute::BasicCompTree<Index> CompTree;
 
-    // create vertex nodes
-    for (int i = 0; i < n; ++i) tree_.create_node(MDNode(vertices_[i], Operation::PRIME, i, i + 1));
+    // nodes in the left-to-right postorder: the reverse of the right-to-left preorder
+    std::vector<Index> order;
+    comp_tree.dfs_reverse_preorder_nodes(comp_root, order);
+    std::reverse(order.begin(), order.end());
 
-    // index mapping of internal nodes
-    std::map<int, int> mapping;
-    for (int i = 0; i < n; ++i) mapping[vertices_[i]] = i;
+    // index mapping from the computation tree; sized by capacity, so compact the tree beforehand to keep it small
+    std::vector<int> mapping(comp_tree.capacity());
 
-    // create internal nodes from the bottom
-    auto bfs_order = comp_tree.bfs_nodes(comp_root);
+    // create vertex nodes, which come in the left-to-right order
+    for (auto x : order) {
+      if (!comp_tree[x].data.is_vertex_node()) continue;
+      int i = vertices_.size();
+      vertices_.push_back(comp_tree[x].data.vertex);
+      mapping[x] = tree_.create_node(MDNode(vertices_.back(), Operation::PRIME, i, i + 1));
+    }
 
-    for (auto it = bfs_order.rbegin(); it != bfs_order.rend(); ++it) {
-      if (comp_tree[*it].data.is_vertex_node()) continue;
-      if (comp_tree[*it].data.is_problem_node()) throw std::invalid_argument("should not be a problem node");
+    // create internal nodes from the bottom; the vertices of a node end where those of its last child end
+    for (auto x : order) {
+      auto &&nd = comp_tree[x];
+      if (nd.data.is_vertex_node()) continue;
+      if (nd.data.is_problem_node()) throw std::invalid_argument("should not be a problem node");
 
-      auto children = comp_tree.get_children(*it);
-      auto op = comp_tree[*it].data.op_type;
-      int idx_begin = n, idx_end = 0;
-      for (auto c : children) {
-        idx_begin = std::min(idx_begin, tree_[mapping[c]].data.vertices_begin);
-        idx_end = std::max(idx_end, tree_[mapping[c]].data.vertices_end);
-      }
+      Index last = nd.first_child;
+      while (comp_tree[last].right != CompTree::NOT_AVAILABLE) last = comp_tree[last].right;
 
-      auto node_idx = tree_.create_node(MDNode(-1, op, idx_begin, idx_end));
-      // printf("*it=%d, idx=%d, b=%d, e=%d\n", *it, node_idx, idx_begin, idx_end);
-      for (auto cit = children.rbegin(); cit != children.rend(); ++cit) tree_.move_to(mapping[*cit], node_idx);
-      mapping[*it] = node_idx;
-      // std::cout << tree_.to_string(node_idx) << std::endl;
+      int idx_begin = tree_[mapping[nd.first_child]].data.vertices_begin;
+      int idx_end = tree_[mapping[last]].data.vertices_end;
+      auto node_idx = tree_.create_node(MDNode(-1, nd.data.op_type, idx_begin, idx_end));
+      for (auto c = last; c != CompTree::NOT_AVAILABLE; c = comp_tree[c].left) {
+        tree_.move_to(mapping[c], node_idx);
+      }
+      mapping[x] = node_idx;
     }
 
     // set root
@@ -111,40 +161,50 @@ class MDTree {
    * @brief Sorts all nodes in lexicographical order.
    */
   void sort() {
-    auto level_order = tree_.bfs_nodes(root_);
+    if (root_ < 0) return;
+
+    // left-to-right postorder: the reverse of the right-to-left preorder
+    std::vector<int> order;
+    tree_.dfs_reverse_preorder_nodes(root_, order);
+    std::reverse(order.begin(), order.end());
 
     // first pass (bottom-up): find the (lexicographically) smallest vertex for each module
-    std::map<int, VertexID> min_label;
-    for (auto it = level_order.rbegin(); it != level_order.rend(); ++it) {
-      if (tree_[*it].is_leaf()) min_label[*it] = tree_[*it].data.vertex;
-      if (!tree_[*it].is_root()) {
-        auto p = tree_[*it].parent;
-        auto nd = min_label[*it];
-        min_label[p] = util::contains(min_label, p) ? std::min(min_label[p], nd) : nd;
+    VertexID max_label = 0;
+    for (auto v : vertices_) max_label = std::max(max_label, v);
+    std::vector<VertexID> min_label(tree_.capacity(), max_label + 1);
+    std::vector<int> leaf_of(max_label + 1, -1);
+    for (auto x : order) {
+      if (tree_[x].is_leaf()) {
+        min_label[x] = tree_[x].data.vertex;
+        leaf_of[min_label[x]] = x;
+      }
+      if (!tree_[x].is_root()) {
+        auto p = tree_[x].parent;
+        min_label[p] = std::min(min_label[p], min_label[x]);
       }
     }
 
-    // second pass (top-down): reorder nodes and vertices
-    std::map<int, int> new_begin;
-    new_begin[root_] = 0;
-    for (auto x : level_order) {
-      if (tree_[x].is_leaf()) {
-        vertices_[new_begin[x]] = tree_[x].data.vertex;  // stores the node id
-        continue;
+    // bucket sort by (parent, min_label): the nodes sharing a min label form a path up from its leaf,
+    // so visiting the labels in descending order and moving each node to the front orders every list of children
+    for (VertexID label = max_label; label >= 0; --label) {
+      for (auto c = leaf_of[label]; c >= 0 && !tree_[c].is_root() && min_label[c] == label; c = tree_[c].parent) {
+        tree_.make_first_child(c);
       }
+    }
 
-      std::vector<std::pair<int, int>> cs;
-      for (auto c : tree_.get_children(x)) cs.push_back({min_label[c], c});
-      std::sort(cs.begin(), cs.end());
-
-      auto idx = new_begin[x] + tree_[x].data.size();
-      for (int i = static_cast<int>(cs.size()) - 1; i >= 0; --i) {
-        auto c = cs[i].second;
-        idx -= tree_[c].data.size();
-        new_begin[c] = idx;
-        tree_[c].data.vertices_end = idx + tree_[c].data.size();
-        tree_[c].data.vertices_begin = idx;
-        tree_.make_first_child(c);
+    // second pass (bottom-up): renumber vertices in the new order
+    tree_.dfs_reverse_preorder_nodes(root_, order);
+    std::reverse(order.begin(), order.end());
+    int idx = 0;
+    for (auto x : order) {
+      auto &data = tree_[x].data;
+      if (tree_[x].is_leaf()) {
+        vertices_[idx] = data.vertex;
+        data.vertices_begin = idx++;
+        data.vertices_end = idx;
+      } else {
+        data.vertices_begin = idx - data.size();
+        data.vertices_end = idx;
       }
     }
   }
@@ -158,10 +218,85 @@ class MDTree {
     return vertices_[index];
   }
   std::string to_string() const { return tree_.to_string(root_); }
+
+  /**
+   * @brief Returns the string representation with the vertices translated to the given labels.
+   *
+   * @param labels labels[v] is the original label of vertex v; see readwrite::load_edge_list_relabeled()
+   */
+  std::string to_string(std::vector<int64_t> const &labels) const {
+    if (labels.empty()) return to_string();
+    return tree_.to_string(root_, [&labels](std::ostream &os, MDNode const &node) {
+      if (node.is_vertex_node()) {
+        os << labels.at(node.vertex);
+      } else {
+        os << node;
+      }
+    });
+  }
+};
+
+/**
+ * @brief Set of vertices split recursively into connected components or co-components.
+ *
+ * A leaf holds the decomposition of its induced subgraph on the local vertices 0, 1, ... (none for a single vertex).
+ * An inner node joins the decompositions of its children, ordered by their smallest vertices, under a node of type
+ * `op`: PARALLEL for connected components and SERIES for the connected components of the complement.
+ */
+struct MDPart {
+  std::vector<VertexID> vertices;  // vertices of the whole graph in increasing order
+  MDTree tree;
+  Operation op;
+  std::vector<std::unique_ptr<MDPart>> children;
 };
 
 MDTree modular_decomposition(ds::graph::Graph const &graph, bool sorted = false);
 
+/**
+ * @brief Computes the modular decomposition, solving the connected components and co-components concurrently.
+ *
+ * The graph is split recursively as long as the parts shrink enough; each remaining part is solved on its own.
+ *
+ * @param num_threads number of threads; 0 means all hardware threads
+ */
+MDTree modular_decomposition(ds::graph::CSRGraph const &graph, bool sorted = false, int num_threads = 1);
+
+template <typename Index>
+MDTree modular_decomposition(ds::graph::CSRGraph const &graph, compute::BasicSolverWorkspace<Index> &ws,
+                             bool sorted = false) {
+  return MDTree(graph, ws, sorted);
+}
+
 std::pair<MDTree, double> modular_decomposition_time(ds::graph::Graph const &graph, bool sorted = false,
                                                      util::Profiler *prof = nullptr);
+
+/**
+ * @brief Computes the modular decomposition and measures the elapsed time, excluding sorting.
+ *
+ * @param prof profiler; requires a single thread, since the concurrent solver is not profiled
+ * @param num_threads number of threads; 0 means all hardware threads
+ * @throw std::invalid_argument if `prof` is given and more than one thread is requested
+ */
+std::pair<MDTree, double> modular_decomposition_time(ds::graph::CSRGraph const &graph, bool sorted = false,
+                                                     util::Profiler *prof = nullptr, int num_threads = 1);
+
+/**
+ * @brief Computes the modular decompositions of many graphs, one graph per thread at a time.
+ *
+ * Each thread loads and solves the graphs it takes with its own workspace, so the solver's buffers are reused
+ * across the batch. Graphs with at most 4096 vertices are solved with 16-bit tree indices.
+ * Results are passed to `emit` in input order as soon as all earlier ones are out,
+ * and at most a few graphs per thread are kept waiting for an earlier one.
+ *
+ * @param count number of graphs
+ * @param load load(i) returns the i-th graph; called concurrently
+ * @param emit emit(i, tree) receives the result for the i-th graph; called once at a time, for i = 0, 1, ...
+ * @param num_threads number of threads; 0 means all hardware threads
+ */
+void decompose_batch(std::size_t count, std::function<ds::graph::CSRGraph(std::size_t)> const &load,
+                     std::function<void(std::size_t, MDTree &&)> const &emit, bool sorted = false,
+                     int num_threads = 1);
+
+std::vector<MDTree> decompose_batch(std::vector<ds::graph::CSRGraph> const &graphs, bool sorted = false,
+                                    int num_threads = 1);
 }  // namespace modular
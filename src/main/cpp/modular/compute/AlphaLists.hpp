@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "ds/graph/CSRGraph.hpp"
+#include "modular/compute/MDComputeNode.hpp"
+
+namespace modular {
+namespace compute {
+/**
+ * @brief Alpha lists of all vertices stored in a single arena.
+ *
+ * Each vertex owns one contiguous segment of the arena, initially sized by its degree,
+ * which bounds the number of pivots added to the list by neighbor processing.
+ * A full segment is moved to the end of the arena with doubled capacity.
+ * Clearing a list keeps its segment, so the arena is allocated once and reused for the whole computation.
+ *
+ * @tparam V integer type of the stored vertices
+ */
+template <typename V>
+class BasicAlphaLists {
+ public:
+  /**
+   * @brief Non-owning view of one alpha list; invalidated by push_back().
+   */
+  class Range {
+   private:
+    V const* begin_;
+    V const* end_;
+
+   public:
+    Range(V const* begin, V const* end) : begin_(begin), end_(end) {}
+
+    V const* begin() const { return begin_; }
+    V const* end() const { return end_; }
+    std::size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    V operator[](std::size_t i) const { return begin_[i]; }
+  };
+
+ private:
+  struct Segment {
+    std::size_t begin;
+    int size;
+    int capacity;
+  };
+
+  std::vector<Segment> segments_;
+  std::vector<V> arena_;
+
+  void grow(int v) {
+    auto &s = segments_[v];
+    auto capacity = std::max(4, 2 * s.capacity);
+    auto begin = arena_.size();
+    arena_.resize(begin + capacity);
+    std::copy(arena_.begin() + s.begin, arena_.begin() + s.begin + s.size, arena_.begin() + begin);
+    s.begin = begin;
+    s.capacity = capacity;
+  }
+
+ public:
+  BasicAlphaLists() {}
+
+  BasicAlphaLists(ds::graph::CSRGraph const &graph) { reset(graph); }
+
+  /**
+   * @brief Empties all lists and lays out the segments for the given graph, reusing the allocated storage.
+   */
+  void reset(ds::graph::CSRGraph const &graph) {
+    std::size_t n = graph.number_of_nodes();
+    segments_.resize(n);
+    for (std::size_t v = 0; v < n; ++v) segments_[v] = {graph.offsets()[v], 0, graph.degree(v)};
+    arena_.resize(graph.offsets()[n]);
+  }
+
+  std::size_t size(int v) const { return segments_[v].size; }
+
+  Range operator[](int v) const {
+    auto p = arena_.data() + segments_[v].begin;
+    return Range(p, p + segments_[v].size);
+  }
+
+  /**
+   * @brief Mutable access to the elements of one alpha list; invalidated by push_back().
+   */
+  V *data(int v) { return arena_.data() + segments_[v].begin; }
+
+  void push_back(int v, V x) {
+    auto &s = segments_[v];
+    if (s.size == s.capacity) grow(v);
+    arena_[s.begin + s.size++] = x;
+  }
+
+  void pop_back(int v) { --segments_[v].size; }
+
+  void clear(int v) { segments_[v].size = 0; }
+};
+
+typedef BasicAlphaLists<VertexID> AlphaLists;
+}  // namespace compute
+}  // namespace modular
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ostream>
 #include <string>
 
 namespace modular {
@@ -11,60 +12,52 @@ enum SplitDirection { NONE, LEFT, RIGHT, MIXED };
 
 typedef int VertexID;
 
-class MDComputeNode {
+/**
+ * @brief Node of the computation tree.
+ *
+ * Kept small for cache efficiency: the type flags are packed into one byte,
+ * and the counters used only in refinement live in BasicRefinementCounters.
+ *
+ * @tparam Index integer type for vertices and tree nodes, the same as that of the computation tree
+ */
+template <typename Index>
+class BasicMDComputeNode {
  public:
-  NodeType node_type;
-  Operation op_type;
-  SplitDirection split_type;
-  VertexID vertex;  // pivot for problem node
-  int comp_number;
-  int tree_number;
-  int num_marks;
-  int num_left_split_children;   // number of the children with split LEFT or MIXED; used only in refinement
-  int num_right_split_children;  // number of the children with split RIGHT or MIXED; used only in refinement
-  bool active;
-  bool connected;
-
-  MDComputeNode(NodeType node_type = NodeType::PROBLEM)
-      : node_type(node_type),  //
+  static Index const NOT_AVAILABLE = static_cast<Index>(-1);  // unset number or no pivot
+
+  Index vertex;  // pivot for problem node
+  Index comp_number;
+  Index tree_number;
+  NodeType node_type : 2;
+  Operation op_type : 2;
+  SplitDirection split_type : 2;
+  bool active : 1;
+  bool connected : 1;
+
+  BasicMDComputeNode(NodeType node_type = NodeType::PROBLEM)
+      : vertex(NOT_AVAILABLE),  //
+        comp_number(NOT_AVAILABLE),
+        tree_number(NOT_AVAILABLE),
+        node_type(node_type),
         op_type(Operation::PRIME),
         split_type(SplitDirection::NONE),
-        vertex(-1),
-        comp_number(-1),
-        tree_number(-1),
-        num_marks(0),
-        num_left_split_children(0),
-        num_right_split_children(0),
         active(false),
         connected(false) {}
 
-  MDComputeNode(MDComputeNode const &node)
-      : node_type(node.node_type),
-        op_type(node.op_type),
-        split_type(node.split_type),
-        vertex(node.vertex),
-        comp_number(node.comp_number),
-        tree_number(node.tree_number),
-        num_marks(node.num_marks),
-        num_left_split_children(0),   // initialize to zero, not copying from the original
-        num_right_split_children(0),  // initialize to zero, not copying from the original
-        active(node.active),
-        connected(node.connected) {}
-
-  static MDComputeNode new_vertex_node(VertexID vertex) {
-    auto ret = MDComputeNode(NodeType::VERTEX);
+  static BasicMDComputeNode new_vertex_node(Index vertex) {
+    auto ret = BasicMDComputeNode(NodeType::VERTEX);
     ret.vertex = vertex;
     return ret;
   }
 
-  static MDComputeNode new_operation_node(Operation op_type) {
-    auto ret = MDComputeNode(NodeType::OPERATION);
+  static BasicMDComputeNode new_operation_node(Operation op_type) {
+    auto ret = BasicMDComputeNode(NodeType::OPERATION);
     ret.op_type = op_type;
     return ret;
   }
 
-  static MDComputeNode new_problem_node(bool connected) {
-    auto ret = MDComputeNode(NodeType::PROBLEM);
+  static BasicMDComputeNode new_problem_node(bool connected) {
+    auto ret = BasicMDComputeNode(NodeType::PROBLEM);
     ret.connected = connected;
     return ret;
   }
@@ -73,12 +66,7 @@ class MDComputeNode {
   bool is_operation_node() const { return node_type == NodeType::OPERATION; }
   bool is_problem_node() const { return node_type == NodeType::PROBLEM; }
 
-  bool is_marked() const { return num_marks > 0; }
-  void add_mark() { ++num_marks; }
-  int number_of_marks() const { return num_marks; }
-  void clear_marks() { num_marks = 0; }
-
-  bool is_split_marked(SplitDirection split_type) {
+  bool is_split_marked(SplitDirection split_type) const {
     return this->split_type == SplitDirection::MIXED || this->split_type == split_type;
   }
 
@@ -92,6 +80,56 @@ class MDComputeNode {
     }
   }
 
+  void clear() {
+    comp_number = NOT_AVAILABLE;
+    tree_number = NOT_AVAILABLE;
+    split_type = SplitDirection::NONE;
+  }
+
+  std::string to_string() const {
+    switch (node_type) {
+      case NodeType::VERTEX: return std::to_string(vertex); break;
+      case NodeType::OPERATION:
+        switch (op_type) {
+          case Operation::PRIME: return "P"; break;
+          case Operation::SERIES: return "J"; break;
+          case Operation::PARALLEL: return "U"; break;
+        }
+      case NodeType::PROBLEM: return vertex == NOT_AVAILABLE ? "C-" : "C" + std::to_string(vertex);
+    }
+    return "";
+  }
+};
+
+template <typename Index>
+Index const BasicMDComputeNode<Index>::NOT_AVAILABLE;
+
+template <typename Index>
+std::ostream &operator<<(std::ostream &os, BasicMDComputeNode<Index> const &node) {
+  return os << node.to_string();
+}
+
+typedef BasicMDComputeNode<VertexID> MDComputeNode;
+
+/**
+ * @brief Counters of one computation tree node used only in refinement.
+ *
+ * @tparam Index integer type for tree nodes; the counters are bounded by the number of children
+ */
+template <typename Index>
+class BasicRefinementCounters {
+ public:
+  Index num_marks;
+  Index num_left_split_children;   // number of the children with split LEFT or MIXED
+  Index num_right_split_children;  // number of the children with split RIGHT or MIXED
+
+  BasicRefinementCounters() : num_marks(0), num_left_split_children(0), num_right_split_children(0) {}
+
+  bool is_marked() const { return num_marks > 0; }
+  void add_mark() { ++num_marks; }
+  Index number_of_marks() const { return num_marks; }
+  void clear_marks() { num_marks = 0; }
+
   void increment_num_split_children(SplitDirection split_type) {
     if (split_type == SplitDirection::LEFT) {
       ++num_left_split_children;
@@ -108,36 +146,12 @@ class MDComputeNode {
     }
   }
 
-  int get_num_split_children(SplitDirection split_type) const {
+  Index get_num_split_children(SplitDirection split_type) const {
     return split_type == SplitDirection::LEFT ? num_left_split_children : num_right_split_children;
   }
-
-  void clear_num_split_children() { num_left_split_children = num_right_split_children = 0; }
-
-  void clear() {
-    comp_number = -1;
-    tree_number = -1;
-    // num_marks = 0;
-    split_type = SplitDirection::NONE;
-    clear_num_split_children();
-  }
-
-  std::string to_string() const {
-    switch (node_type) {
-      case NodeType::VERTEX: return std::to_string(vertex); break;
-      case NodeType::OPERATION:
-        switch (op_type) {
-          case Operation::PRIME: return "P"; break;
-          case Operation::SERIES: return "J"; break;
-          case Operation::PARALLEL: return "U"; break;
-        }
-      case NodeType::PROBLEM: return vertex < 0 ? "C-" : "C" + std::to_string(vertex);
-    }
-    return "";
-  }
 };
 
-std::ostream &operator<<(std::ostream &os, MDComputeNode const &node);
+typedef BasicRefinementCounters<VertexID> RefinementCounters;
 
 }  // namespace compute
 }  // namespace modular
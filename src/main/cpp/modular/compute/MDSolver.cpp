@@ -4,21 +4,21 @@ namespace modular {
 namespace compute {
 namespace impl {
 
-int compute(ds::graph::Graph const &graph, CompTree &tree, int main_prob, util::Profiler *prof) {
+template <typename Index>
+Index compute(ds::graph::CSRGraph const &graph, BasicSolverWorkspace<Index> &ws, Index main_prob,
+              util::Profiler *prof) {
+  auto &tree = ws.tree;
   TRACE("start compute(): %s", tree.to_string(main_prob).c_str());
   PROF(util::pstart(prof, "compute()"));
 
   int n = graph.number_of_nodes();
-  int current_prob = main_prob;
+  Index current_prob = main_prob;
 
-  VVV alpha_list(n);
-  VVV fp_neighbors(n);  // used only for assembly -> compute_fact_perm_edges()
-  bool visited[n];
-  for (int i = 0; i < n; ++i) {
-    visited[i] = false;
-  }
-  ds::FastSet vset(n);
-  int result = -1;
+  auto &alpha_list = ws.alpha_list;
+  auto &fp_neighbors = ws.fp_neighbors;
+  auto &visited = ws.visited;
+  auto &vset = ws.vset;
+  Index result = BasicCompTree<Index>::NOT_AVAILABLE;
   int t = 0;
 
   while (tree.is_valid(current_prob)) {
@@ -27,13 +27,13 @@ int compute(ds::graph::Graph const &graph, CompTree &tree, int main_prob, util::
     TRACE("current problem: %s", tree.to_string(current_prob).c_str());
     for (int i = 0; i < n; ++i) {
       TRACE("visited [%d]: %s", i, visited[i] ? "True" : "False");
-      TRACE("alpha [%d]: %s", i, util::to_string(alpha_list[i]).c_str());
+      TRACE("alpha [%d]: %s", i, util::to_string(alpha_list[i].begin(), alpha_list[i].end()).c_str());
     }
 
-    auto &cp = tree[current_prob];
+    auto &&cp = tree[current_prob];
     cp.data.active = true;
 
-    auto &fc = tree[cp.first_child];
+    auto &&fc = tree[cp.first_child];
 
     if (!fc.data.is_problem_node()) {
       // first, needs to solve subproblems
@@ -43,7 +43,8 @@ int compute(ds::graph::Graph const &graph, CompTree &tree, int main_prob, util::
         // base case
         PROF(util::pcount(prof, "solve(): base case"));
         PROF(util::pstart(prof, "process_neighbors()"));
-        process_neighbors(graph, tree, alpha_list, visited, cp.first_child, current_prob, -1);
+        process_neighbors(graph, tree, alpha_list, visited, cp.first_child, current_prob,
+                          BasicCompTree<Index>::NOT_AVAILABLE);
         PROF(util::pstop(prof, "process_neighbors()"));
       } else {
         // pivot at the first child
@@ -67,12 +68,13 @@ int compute(ds::graph::Graph const &graph, CompTree &tree, int main_prob, util::
       PROF(util::pstop(prof, "remove_layers()"));
 
       PROF(util::pstart(prof, "complete_alpha_lists()"));
-      std::vector<int> leaves = tree.get_leaves(current_prob);
+      auto &leaves = ws.leaves;
+      tree.get_leaves(current_prob, leaves);
       complete_alpha_lists(tree, alpha_list, vset, current_prob, leaves);
       PROF(util::pstop(prof, "complete_alpha_lists()"));
 
       PROF(util::pstart(prof, "refine()"));
-      refine(tree, alpha_list, current_prob, leaves, prof);
+      refine(tree, alpha_list, current_prob, leaves, ws.counters, prof);
       PROF(util::pstop(prof, "refine()"));
 
       PROF(util::pstart(prof, "promote()"));
@@ -85,8 +87,8 @@ int compute(ds::graph::Graph const &graph, CompTree &tree, int main_prob, util::
 
       // clear all but visited
       PROF(util::pstart(prof, "clear all but visited"));
-      for (auto c: tree.dfs_reverse_preorder_nodes(tree[current_prob].first_child)) {
-        if (tree[c].is_leaf()) alpha_list[c].clear();
+      for (auto c : tree.dfs_reverse_preorder(tree[current_prob].first_child)) {
+        if (tree[c].is_leaf()) alpha_list.clear(c);
         tree[c].data.clear();
       }
       PROF(util::pstop(prof, "clear all but visited"));
@@ -110,6 +112,12 @@ int compute(ds::graph::Graph const &graph, CompTree &tree, int main_prob, util::
   TRACE("return: %s", tree.to_string(result).c_str());
   return result;
 }
+
+#define INSTANTIATE(Index) \
+  template Index compute(ds::graph::CSRGraph const &, BasicSolverWorkspace<Index> &, Index, util::Profiler *);
+MODULAR_FOR_EACH_INDEX_TYPE(INSTANTIATE)
+#undef INSTANTIATE
+
 }  // namespace impl
 }  // namespace compute
 }  // namespace modular
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
+#include "ds/graph/CSRGraph.hpp"
 #include "ds/graph/Graph.hpp"
 #include "ds/set/FastSet.hpp"
 #include "ds/tree/IntRootedForest.hpp"
+#include "modular/compute/AlphaLists.hpp"
 #include "modular/compute/MDComputeNode.hpp"
 #include "util/profiler.hpp"
 #include "util/util.hpp"
@@ -10,69 +15,155 @@
 namespace modular {
 namespace compute {
 
-typedef int VertexID;
-typedef ds::tree::IntRootedForest<MDComputeNode> CompTree;
+/**
+ * @brief Computation tree whose nodes and vertices are numbered by the given integer type.
+ */
+template <typename Index>
+using BasicCompTree = ds::tree::IntRootedForest<BasicMDComputeNode<Index>, ds::tree::ArrayOfStructures, Index>;
+
+typedef BasicCompTree<VertexID> CompTree;
+
+/**
+ * @brief Applies the given macro to every index type the solver is instantiated for.
+ *
+ * uint16_t suits batches of tiny graphs, and the wider types allow more than 2^31 tree nodes.
+ */
+#define MODULAR_FOR_EACH_INDEX_TYPE(F) F(uint16_t) F(int) F(uint32_t) F(int64_t)
+
+/**
+ * @brief Buffers used by MDSolver, kept across calls.
+ *
+ * Passing the same workspace to repeated computations reuses the capacity of the computation tree
+ * and the per-vertex buffers instead of allocating them for every graph.
+ *
+ * @tparam Index integer type for vertices and tree nodes; a narrower type halves the tree links and alpha lists,
+ *               and the computation throws std::length_error if the tree needs more nodes than it can index
+ */
+template <typename Index>
+class BasicSolverWorkspace {
+ public:
+  typedef Index index_type;
+
+  BasicCompTree<Index> tree;
+  BasicAlphaLists<Index> alpha_list;
+  std::vector<std::vector<Index>> fp_neighbors;  // used only for assembly -> compute_fact_perm_edges()
+  std::vector<bool> visited;
+  ds::FastSet vset;
+  std::vector<BasicRefinementCounters<Index>> counters;  // used only in refinement; indexed by tree node
+  std::vector<Index> leaves;                              // leaves of the current problem
+
+  /**
+   * @brief Prepares the buffers for the given graph.
+   */
+  void reset(ds::graph::CSRGraph const &graph) {
+    std::size_t n = graph.number_of_nodes();
+    tree.clear();
+    alpha_list.reset(graph);
+    if (fp_neighbors.size() < n) fp_neighbors.resize(n);
+    visited.assign(n, false);
+    vset.resize(n);
+  }
+};
+
+typedef BasicSolverWorkspace<VertexID> SolverWorkspace;
 
 //================================================================================
 //    Subroutines
 //================================================================================
+// instantiated for MODULAR_FOR_EACH_INDEX_TYPE
 namespace impl {
 typedef std::vector<bool> VB;
-typedef std::vector<int> VI;
-typedef std::vector<std::pair<int, int>> VII;
-typedef std::vector<std::vector<VertexID>> VVV;
-
-int compute(ds::graph::Graph const &graph, CompTree &tree, int main_prob, util::Profiler *prof = nullptr);
-
-void process_neighbors(             //
-    ds::graph::Graph const &graph,  //
-    CompTree &tree,                 //
-    VVV &alpha_list,                //
-    bool const visited[],           //
-    VertexID pivot,                 //
-    int current_prob,               //
-    int nbr_prob                    //
+
+template <typename Index>
+Index compute(ds::graph::CSRGraph const &graph, BasicSolverWorkspace<Index> &ws, Index main_prob,
+              util::Profiler *prof = nullptr);
+
+template <typename Index>
+void process_neighbors(                  //
+    ds::graph::CSRGraph const &graph,    //
+    BasicCompTree<Index> &tree,          //
+    BasicAlphaLists<Index> &alpha_list,  //
+    VB const &visited,                   //
+    Index pivot,                         //
+    Index current_prob,                  //
+    Index nbr_prob                       //
 );
-int do_pivot(ds::graph::Graph const &graph,  //
-             CompTree &tree,                 //
-             VVV &alpha_list,                //
-             bool const visited[],           //
-             int prob,                       //
-             VertexID pivot                  //
+template <typename Index>
+Index do_pivot(ds::graph::CSRGraph const &graph,    //
+               BasicCompTree<Index> &tree,          //
+               BasicAlphaLists<Index> &alpha_list,  //
+               VB const &visited,                   //
+               Index prob,                          //
+               Index pivot                          //
 );
-int remove_extra_components(CompTree &tree, int prob);
-void remove_layers(CompTree &tree, int prob);
-void complete_alpha_lists(CompTree &tree, VVV &alpha_list, ds::FastSet &vset, int prob, std::vector<int> &leaves);
-void merge_components(CompTree &tree, int problem, int new_components);
-
-void refine(CompTree &tree, VVV const &alpha_list, int prob, std::vector<int> &leaves, util::Profiler *prof);
-void promote(CompTree &tree, int prob);
-void assemble(CompTree &tree, VVV const &alpha_list, int prob, VVV &fp_neighbors, ds::FastSet &vset, util::Profiler *prof);
+template <typename Index>
+Index remove_extra_components(BasicCompTree<Index> &tree, Index prob);
+template <typename Index>
+void remove_layers(BasicCompTree<Index> &tree, Index prob);
+template <typename Index>
+void complete_alpha_lists(BasicCompTree<Index> &tree, BasicAlphaLists<Index> &alpha_list, ds::FastSet &vset,
+                          Index prob, std::vector<Index> &leaves);
+template <typename Index>
+void merge_components(BasicCompTree<Index> &tree, Index problem, Index new_components);
+
+template <typename Index>
+void refine(BasicCompTree<Index> &tree, BasicAlphaLists<Index> const &alpha_list, Index prob,
+            std::vector<Index> &leaves, std::vector<BasicRefinementCounters<Index>> &counters, util::Profiler *prof);
+template <typename Index>
+void promote(BasicCompTree<Index> &tree, Index prob);
+template <typename Index>
+void assemble(BasicCompTree<Index> &tree, BasicAlphaLists<Index> const &alpha_list, Index prob,
+              std::vector<std::vector<Index>> &fp_neighbors, ds::FastSet &vset, util::Profiler *prof);
 }  // namespace impl
 
 class MDSolver {
  public:
   static std::pair<CompTree, int> compute(ds::graph::Graph const &graph, util::Profiler *prof = nullptr) {
+    return compute(ds::graph::CSRGraph(graph), prof);
+  }
+
+  static std::pair<CompTree, int> compute(ds::graph::CSRGraph const &graph, util::Profiler *prof = nullptr) {
+    SolverWorkspace ws;
+    auto root = compute(graph, ws, prof);
+    return {std::move(ws.tree), root};
+  }
+
+  /**
+   * @brief Computes the modular decomposition using the buffers in the given workspace.
+   *
+   * @return root of the result in `ws.tree`; NOT_AVAILABLE (-1 for int) if the graph is empty
+   * @throw std::length_error if the computation tree needs more nodes than `Index` can number
+   */
+  template <typename Index>
+  static Index compute(ds::graph::CSRGraph const &graph, BasicSolverWorkspace<Index> &ws,
+                       util::Profiler *prof = nullptr) {
     // build computation tree
-    CompTree tree;
+    auto &tree = ws.tree;
     int n = graph.number_of_nodes();
-    if (n == 0) return {tree, -1};
+    if (n == 0) {
+      tree.clear();
+      return BasicCompTree<Index>::NOT_AVAILABLE;
+    }
+    ws.reset(graph);
 
     // the first n nodes should be vertex nodes (cannot be removed)
-    for (int i = 0; i < n; ++i) { tree.create_node(MDComputeNode::new_vertex_node(i)); }
+    for (int i = 0; i < n; ++i) { tree.create_node(BasicMDComputeNode<Index>::new_vertex_node(i)); }
 
     // create the main problem
-    auto main_prob = tree.create_node(MDComputeNode::new_problem_node(false));
+    auto main_prob = tree.create_node(BasicMDComputeNode<Index>::new_problem_node(false));
 
     // initially, all vertex nodes are the children of the main problem
     for (int i = n - 1; i >= 0; --i) tree.move_to(i, main_prob);
 
     // main logic
-    auto new_root = impl::compute(graph, tree, main_prob, prof);
+    auto new_root = impl::compute(graph, ws, main_prob, prof);
+
+    // renumber the surviving nodes, which are scattered by repeated removal and reuse
+    new_root = tree.compact(n)[new_root];
 
     // return result
     TRACE("result: %s", tree.to_string(new_root).c_str());
-    return {tree, new_root};
+    return new_root;
   }
 
  private:
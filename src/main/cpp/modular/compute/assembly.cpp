@@ -3,6 +3,7 @@
 namespace modular {
 namespace compute {
 namespace impl {
+typedef std::vector<std::pair<int, int>> VII;
 
 //================================================================================
 //    Determine flags
@@ -12,10 +13,13 @@ namespace impl {
  *
  * @note Read: MDNode::comp_number for each root
  */
-static std::vector<bool> determine_left_cocomp_fragments(CompTree const &tree, VI const &ps, int pivot_index) {
+template <typename Index>
+static std::vector<bool> determine_left_cocomp_fragments(BasicCompTree<Index> const &tree, std::vector<Index> const &ps,
+                                                         int pivot_index) {
   std::vector<bool> ret(ps.size());
   for (int i = 1; i < pivot_index; ++i) {
-    ret[i] = tree[ps[i]].data.comp_number >= 0 && tree[ps[i - 1]].data.comp_number == tree[ps[i]].data.comp_number;
+    auto c = tree[ps[i]].data.comp_number;
+    ret[i] = c != BasicMDComputeNode<Index>::NOT_AVAILABLE && tree[ps[i - 1]].data.comp_number == c;
   }
   return ret;
 }
@@ -25,10 +29,13 @@ static std::vector<bool> determine_left_cocomp_fragments(CompTree const &tree, V
  *
  * @note Read: MDNode::comp_number for each root
  */
-static std::vector<bool> determine_right_comp_fragments(CompTree const &tree, VI const &ps, int pivot_index) {
+template <typename Index>
+static std::vector<bool> determine_right_comp_fragments(BasicCompTree<Index> const &tree, std::vector<Index> const &ps,
+                                                        int pivot_index) {
   std::vector<bool> ret(ps.size());
   for (int i = pivot_index + 1; i < static_cast<int>(ps.size()) - 1; ++i) {
-    ret[i] = tree[ps[i]].data.comp_number >= 0 && tree[ps[i]].data.comp_number == tree[ps[i + 1]].data.comp_number;
+    auto c = tree[ps[i]].data.comp_number;
+    ret[i] = c != BasicMDComputeNode<Index>::NOT_AVAILABLE && c == tree[ps[i + 1]].data.comp_number;
   }
   return ret;
 }
@@ -39,15 +46,19 @@ static std::vector<bool> determine_right_comp_fragments(CompTree const &tree, VI
  * @note Read: MDNode::tree_number for each root and leaf
  *             MDLeaf::alpha       for each leaf
  */
-static std::vector<bool> determine_right_layer_neighbor(CompTree const &tree, VVV const &alpha_list, VI const &ps, int pivot_index) {
+template <typename Index>
+static std::vector<bool> determine_right_layer_neighbor(BasicCompTree<Index> const &tree,
+                                                        BasicAlphaLists<Index> const &alpha_list,
+                                                        std::vector<Index> const &ps, int pivot_index) {
   std::vector<bool> ret(ps.size());
   for (int i = pivot_index + 1; i < static_cast<int>(ps.size()); ++i) {
-    int current_tree = ps[i];
-    int current_tree_num = tree[current_tree].data.tree_number;
+    Index current_tree = ps[i];
+    Index current_tree_num = tree[current_tree].data.tree_number;
 
-    for (auto leaf : tree.get_leaves(current_tree)) {
+    for (auto leaf : tree.leaves(current_tree)) {
       for (auto a : alpha_list[leaf]) {
-        if (tree[a].data.tree_number > current_tree_num) {
+        auto t = tree[a].data.tree_number;
+        if (t != BasicMDComputeNode<Index>::NOT_AVAILABLE && t > current_tree_num) {
           ret[i] = true;
           break;
         }
@@ -70,21 +81,17 @@ static std::vector<bool> determine_right_layer_neighbor(CompTree const &tree, VV
  *       Update: MDLeaf::comp_number for each leaf
  * 
  */
-static void compute_fact_perm_edges(CompTree &tree, VVV const &alpha_list, VI const &ps, int pivot_index,
-                                    ds::FastSet &vset, VVV &fp_neighbors) {
+template <typename Index>
+static void compute_fact_perm_edges(BasicCompTree<Index> &tree, BasicAlphaLists<Index> const &alpha_list,
+                                    std::vector<Index> const &ps, int pivot_index, ds::FastSet &vset,
+                                    std::vector<std::vector<Index>> &fp_neighbors) {
   // TRACE("start: %s\n", to_string().c_str());
   int k = static_cast<int>(ps.size());
   for (int i = 0; i < pivot_index; ++i) fp_neighbors[i].clear();
-  std::vector<std::vector<int>> leaves(pivot_index);
 
   // initialize
   for (int i = 0; i < k; ++i) {
-    if (i < pivot_index) {
-      leaves[i] = tree.get_leaves(ps[i]);
-      for (auto leaf : leaves[i]) tree[leaf].data.comp_number = i;  // reset the comp number to index
-    } else {
-      for (auto leaf : tree.get_leaves(ps[i])) tree[leaf].data.comp_number = i;  // reset the comp number to index
-    }
+    for (auto leaf : tree.leaves(ps[i])) tree[leaf].data.comp_number = i;  // reset the comp number to index
   }
 
   // we need the neighbors only up to pivot_index
@@ -93,9 +100,9 @@ static void compute_fact_perm_edges(CompTree &tree, VVV const &alpha_list, VI co
 
     // enumerate all edges
     bool done = false;
-    for (auto leaf : leaves[i]) {
+    for (auto leaf : tree.leaves(ps[i])) {
       for (auto a : alpha_list[leaf]) {
-        int j = tree[a].data.comp_number;
+        Index j = tree[a].data.comp_number;
 
         if (!vset.get(j)) {
           fp_neighbors[i].push_back(j);
@@ -122,7 +129,9 @@ static void compute_fact_perm_edges(CompTree &tree, VVV const &alpha_list, VI co
 /**
  * @brief Computes the mu-value for each factorizing permutation element.
  */
-static std::vector<int> compute_mu(CompTree const &tree, VI const &ps, int pivot_index, VVV const &neighbors) {
+template <typename Index>
+static std::vector<int> compute_mu(BasicCompTree<Index> const &tree, std::vector<Index> const &ps, int pivot_index,
+                                   std::vector<std::vector<Index>> const &neighbors) {
   // TRACE("start: %s\n", to_string().c_str());
   std::vector<int> mu(ps.size());
 
@@ -137,7 +146,7 @@ static std::vector<int> compute_mu(CompTree const &tree, VI const &ps, int pivot
       if (mu[j] == i) mu[j] = i + 1;
 
       // Current has an edge past previous farthest edge, so must update mu.
-      if (j > mu[i]) mu[i] = j;
+      if (static_cast<int>(j) > mu[i]) mu[i] = j;
     }
   }
 
@@ -255,7 +264,9 @@ static VII delineate(int pivot_index, std::vector<bool> const &lcocomp, std::vec
 //================================================================================
 //    Assemble tree
 //================================================================================
-static int assemble_tree(CompTree &tree, VI const &ps, int pivot_index, VII const &boundaries) {
+template <typename Index>
+static Index assemble_tree(BasicCompTree<Index> &tree, std::vector<Index> const &ps, int pivot_index,
+                           VII const &boundaries) {
   // TRC << "start:" << to_string() << ",boundaries=" << boundaries << std::endl;
   int k = static_cast<int>(ps.size());
   auto lb = pivot_index - 1;
@@ -271,7 +282,7 @@ static int assemble_tree(CompTree &tree, VI const &ps, int pivot_index, VII cons
     ++i;
 
     // create the spine
-    auto new_module = tree.create_node(MDComputeNode::new_operation_node(Operation::PRIME));
+    auto new_module = tree.create_node(BasicMDComputeNode<Index>::new_operation_node(Operation::PRIME));
     tree.move_to(last_module, new_module);
 
     bool added_nbrs = false;
@@ -301,14 +312,15 @@ static int assemble_tree(CompTree &tree, VI const &ps, int pivot_index, VII cons
 //================================================================================
 //    Cleaning
 //================================================================================
-static void remove_degenerate_duplicates(CompTree &tree, int index) {
+template <typename Index>
+static void remove_degenerate_duplicates(BasicCompTree<Index> &tree, Index index) {
   auto nodes = tree.bfs_nodes(index);
 
   for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
     if (*it == index) break;
 
-    auto &c = tree[*it];
-    auto &p = tree[c.parent];
+    auto &&c = tree[*it];
+    auto &&p = tree[c.parent];
     if (c.data.op_type == p.data.op_type && c.data.op_type != Operation::PRIME) {
       tree.replace_by_children(*it);
       tree.remove(*it);
@@ -319,15 +331,17 @@ static void remove_degenerate_duplicates(CompTree &tree, int index) {
 //================================================================================
 //    Main process
 //================================================================================
-void assemble(CompTree &tree, VVV const &alpha_list, int prob, VVV &fp_neighbors, ds::FastSet &vset, util::Profiler *prof) {
+template <typename Index>
+void assemble(BasicCompTree<Index> &tree, BasicAlphaLists<Index> const &alpha_list, Index prob,
+              std::vector<std::vector<Index>> &fp_neighbors, ds::FastSet &vset, util::Profiler *prof) {
   if (tree[prob].is_leaf()) throw std::invalid_argument("roots must not be empty");
 
   // build permutation
-  std::vector<int> ps;  // target problems
-  int current_pivot = tree[prob].data.vertex;
+  std::vector<Index> ps;  // target problems
+  Index current_pivot = tree[prob].data.vertex;
   int pivot_index = -1;
 
-  for (auto p : tree.get_children(prob)) {
+  for (auto p : tree.children(prob)) {
     if (p == current_pivot) pivot_index = ps.size();
     ps.push_back(p);
   }
@@ -364,6 +378,12 @@ void assemble(CompTree &tree, VVV const &alpha_list, int prob, VVV &fp_neighbors
   tree.replace_children(prob, root);
 }
 
+#define INSTANTIATE(Index)                                                              \
+  template void assemble(BasicCompTree<Index> &, BasicAlphaLists<Index> const &, Index, \
+                         std::vector<std::vector<Index>> &, ds::FastSet &, util::Profiler *);
+MODULAR_FOR_EACH_INDEX_TYPE(INSTANTIATE)
+#undef INSTANTIATE
+
 }  // namespace impl
 }  // namespace compute
 }  // namespace modular
@@ -5,16 +5,17 @@ namespace compute {
 
 namespace impl {
 
-int remove_extra_components(CompTree &tree, int prob) {
+template <typename Index>
+Index remove_extra_components(BasicCompTree<Index> &tree, Index prob) {
   TRACE("start: %s", tree.to_string(prob).c_str());
 
   auto subprob = tree[prob].first_child;
   while (tree.is_valid(subprob) && tree[subprob].data.connected) subprob = tree[subprob].right;
 
-  int ret = -1;
+  Index ret = BasicCompTree<Index>::NOT_AVAILABLE;
   if (tree.is_valid(subprob)) {
     ret = tree[subprob].first_child;
-    assert(ret >= 0);
+    assert(ret != BasicCompTree<Index>::NOT_AVAILABLE);
     tree.detach(ret);
     assert(tree[subprob].is_leaf());
     tree.remove(subprob);
@@ -27,7 +28,8 @@ int remove_extra_components(CompTree &tree, int prob) {
 /**
  * @brief Replaces the subproblems of this problem with their MD trees.
  */
-void remove_layers(CompTree &tree, int prob) {
+template <typename Index>
+void remove_layers(BasicCompTree<Index> &tree, Index prob) {
   TRACE("start: %s", tree.to_string(prob).c_str());
 
   for (auto c = tree[prob].first_child; tree.is_valid(c);) {
@@ -43,30 +45,34 @@ void remove_layers(CompTree &tree, int prob) {
 /**
  * @brief Makes alpha lists in this subproblem symmetric and irredundant.
  */
-void complete_alpha_lists(CompTree &tree, VVV &alpha_list, ds::FastSet &vset, int prob, std::vector<int> &leaves) {
+template <typename Index>
+void complete_alpha_lists(BasicCompTree<Index> &tree, BasicAlphaLists<Index> &alpha_list, ds::FastSet &vset,
+                          Index prob, std::vector<Index> &leaves) {
   TRACE("start: %s", tree.to_string(prob).c_str());
 
   // complete the list
   for (auto v : leaves) {
-    assert(v >= 0);
-    for (auto a : alpha_list[v]) {
-      assert(a >= 0);
-      alpha_list[a].push_back(v);
+    assert(v != BasicCompTree<Index>::NOT_AVAILABLE);
+    // index-based; pushing to another list may move the arena
+    for (std::size_t i = 0; i < alpha_list.size(v); ++i) {
+      auto a = alpha_list[v][i];
+      assert(a != BasicCompTree<Index>::NOT_AVAILABLE);
+      alpha_list.push_back(a, v);
     }
   }
 
   // remove duplicate entries (in-place)
   for (auto v : leaves) {
-    auto &vs = alpha_list[v];
+    auto vs = alpha_list.data(v);
     vset.clear();
 
-    std::size_t len = vs.size();
+    std::size_t len = alpha_list.size(v);
     for (std::size_t i = 0; i < len;) {
       auto a = vs[i];
       if (vset.get(a)) {
         // found a duplicate; swap with the last element
         vs[i] = vs[--len];
-        vs.pop_back();
+        alpha_list.pop_back(v);
       } else {
         vset.set(a);
         ++i;
@@ -75,7 +81,8 @@ void complete_alpha_lists(CompTree &tree, VVV &alpha_list, ds::FastSet &vset, in
   }
 }
 
-void merge_components(CompTree &tree, int prob, int new_components) {
+template <typename Index>
+void merge_components(BasicCompTree<Index> &tree, Index prob, Index new_components) {
   TRACE("start: prob=%s, new=%s", tree.to_string(prob).c_str(), tree.to_string(new_components).c_str());
 
   if (!tree.is_valid(new_components)) return;
@@ -90,7 +97,7 @@ void merge_components(CompTree &tree, int prob, int new_components) {
     }
     tree.move_to(new_components, prob);
   } else {
-    auto new_root = tree.create_node(MDComputeNode::new_operation_node(Operation::PARALLEL));
+    auto new_root = tree.create_node(BasicMDComputeNode<Index>::new_operation_node(Operation::PARALLEL));
     tree.move_to(new_root, prob);
     tree.move_to(new_components, new_root);
     tree.move_to(fc, new_root);
@@ -99,6 +106,15 @@ void merge_components(CompTree &tree, int prob, int new_components) {
   TRACE("finish: %s", tree.to_string(prob).c_str());
 }
 
+#define INSTANTIATE(Index)                                                                                   \
+  template Index remove_extra_components(BasicCompTree<Index> &, Index);                                     \
+  template void remove_layers(BasicCompTree<Index> &, Index);                                                \
+  template void complete_alpha_lists(BasicCompTree<Index> &, BasicAlphaLists<Index> &, ds::FastSet &, Index, \
+                                     std::vector<Index> &);                                                  \
+  template void merge_components(BasicCompTree<Index> &, Index, Index);
+MODULAR_FOR_EACH_INDEX_TYPE(INSTANTIATE)
+#undef INSTANTIATE
+
 }  // namespace impl
 }  // namespace compute
 }  // namespace modular
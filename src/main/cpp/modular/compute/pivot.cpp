@@ -5,17 +5,19 @@ namespace compute {
 
 namespace impl {
 
-static bool is_pivot_layer(CompTree& tree, int index) {
-  auto& node = tree[index];
+template <typename Index>
+static bool is_pivot_layer(BasicCompTree<Index>& tree, Index index) {
+  auto&& node = tree[index];
 
   if (!tree.is_valid(node.parent)) return false;
-  auto& p = tree[node.parent];
+  auto&& p = tree[node.parent];
 
   return p.data.is_problem_node() && p.data.vertex == node.first_child;
 }
 
-static void pull_forward(CompTree& tree, VertexID v) {
-  TRACE("pull_forward(): v=%d", v);
+template <typename Index>
+static void pull_forward(BasicCompTree<Index>& tree, Index v) {
+  TRACE("pull_forward(): v=%d", static_cast<int>(v));
 
   auto current_layer = tree[v].parent;
   assert(tree.is_valid(current_layer));
@@ -30,7 +32,7 @@ static void pull_forward(CompTree& tree, VertexID v) {
   TRACE("tree[prev_layer].data.active=%d, is_pivot_layer()=%d", tree[prev_layer].data.active, is_pivot_layer(tree, prev_layer));
 
   if (tree[prev_layer].data.active || is_pivot_layer(tree, prev_layer)) {
-    auto new_layer = tree.create_node(MDComputeNode::new_problem_node(true));  // connected problem
+    auto new_layer = tree.create_node(BasicMDComputeNode<Index>::new_problem_node(true));  // connected problem
     tree.move_to_before(new_layer, current_layer);
     prev_layer = new_layer;
     TRACE("new layer formed: %s", tree.to_string(tree[prev_layer].parent).c_str());
@@ -40,27 +42,29 @@ static void pull_forward(CompTree& tree, VertexID v) {
   if (tree[current_layer].is_leaf()) tree.remove(current_layer);  // all leaves in this layer have been removed
 }
 
-void process_neighbors(             //
-    ds::graph::Graph const& graph,  //
-    CompTree& tree,                 //
-    VVV& alpha_list,                //
-    bool const visited[],           //
-    VertexID pivot,                 //
-    int current_prob,               //
-    int nbr_prob                    //
+template <typename Index>
+void process_neighbors(                  //
+    ds::graph::CSRGraph const& graph,    //
+    BasicCompTree<Index>& tree,          //
+    BasicAlphaLists<Index>& alpha_list,  //
+    VB const& visited,                   //
+    Index pivot,                         //
+    Index current_prob,                  //
+    Index nbr_prob                       //
 ) {
-  TRACE("enter: pivot=%d, current_prob=%d, nbr_prob=%d", pivot, current_prob, nbr_prob);
+  TRACE("enter: pivot=%d, current_prob=%d, nbr_prob=%d", static_cast<int>(pivot), static_cast<int>(current_prob),
+        static_cast<int>(nbr_prob));
 
   for (auto nbr : graph.neighbors(pivot)) {
     // TRACE("nbr=%d\n", nbr);
     if (visited[nbr]) {
-      alpha_list[nbr].push_back(pivot);  // add pivot to nbr's alpha list
+      alpha_list.push_back(nbr, pivot);  // add pivot to nbr's alpha list
     } else if (tree[nbr].parent == current_prob) {
       // nbr_prob must be a valid node
       tree.move_to(nbr, nbr_prob);
     } else {
       TRACE("pull_forward(): nbr=%d", nbr);
-      pull_forward(tree, nbr);
+      pull_forward<Index>(tree, nbr);
     }
   }
 }
@@ -70,15 +74,16 @@ void process_neighbors(             //
  *
  * @return MDComputeNode parent of the subproblems
  */
-int do_pivot(ds::graph::Graph const& graph,  //
-             CompTree& tree,                 //
-             VVV& alpha_list,                //
-             bool const visited[],           //
-             int prob,                       //
-             VertexID pivot                  //
+template <typename Index>
+Index do_pivot(ds::graph::CSRGraph const& graph,    //
+               BasicCompTree<Index>& tree,          //
+               BasicAlphaLists<Index>& alpha_list,  //
+               VB const& visited,                   //
+               Index prob,                          //
+               Index pivot                          //
 ) {
   TRACE("start: %s", tree.to_string(prob).c_str());
-  TRACE("pivot: %d", pivot);
+  TRACE("pivot: %d", static_cast<int>(pivot));
 
   // Replace this subproblem with a new one sharing the same attributes.
   // Reuse the current recursive subproblem for non-neighbors of p.
@@ -91,15 +96,15 @@ int do_pivot(ds::graph::Graph const& graph,  //
   // clear attributes
   tree[prob].data.active = false;
   tree[prob].data.connected = false;
-  tree[prob].data.vertex = -1;
+  tree[prob].data.vertex = BasicMDComputeNode<Index>::NOT_AVAILABLE;
 
   // Create a subproblem for the pivot.
-  auto pivot_prob = tree.create_node(MDComputeNode::new_problem_node(true));  // connected problem
+  auto pivot_prob = tree.create_node(BasicMDComputeNode<Index>::new_problem_node(true));  // connected problem
   tree.move_to(pivot_prob, replacement);
   tree.move_to(pivot, pivot_prob);
 
   // Create a subproblem for the neighbors of p.
-  auto nbr_prob = tree.create_node(MDComputeNode::new_problem_node(true));  // connected problem
+  auto nbr_prob = tree.create_node(BasicMDComputeNode<Index>::new_problem_node(true));  // connected problem
   tree.move_to(nbr_prob, replacement);
   process_neighbors(graph, tree, alpha_list, visited, pivot, prob, nbr_prob);
 
@@ -109,10 +114,18 @@ int do_pivot(ds::graph::Graph const& graph,  //
   // Clean up: no neighbors of p in this problem.
   if (tree[nbr_prob].is_leaf()) tree.remove(nbr_prob);
 
-  TRACE("return: %d: %s", replacement, tree.to_string(replacement).c_str());
+  TRACE("return: %d: %s", static_cast<int>(replacement), tree.to_string(replacement).c_str());
   return replacement;
 }
 
+#define INSTANTIATE(Index)                                                                                       \
+  template void process_neighbors(ds::graph::CSRGraph const&, BasicCompTree<Index>&, BasicAlphaLists<Index>&,    \
+                                  VB const&, Index, Index, Index);                                               \
+  template Index do_pivot(ds::graph::CSRGraph const&, BasicCompTree<Index>&, BasicAlphaLists<Index>&, VB const&, \
+                          Index, Index);
+MODULAR_FOR_EACH_INDEX_TYPE(INSTANTIATE)
+#undef INSTANTIATE
+
 }  // namespace impl
 }  // namespace compute
 }  // namespace modular
@@ -5,11 +5,12 @@ namespace compute {
 
 namespace impl {
 
-static void promote_one_node(CompTree &tree, int index, SplitDirection split_type) {
+template <typename Index>
+static void promote_one_node(BasicCompTree<Index> &tree, Index index, SplitDirection split_type) {
   // non-recursive implementation
   if (tree[index].is_leaf()) return;
 
-  std::stack<std::pair<bool, int>> st;
+  std::stack<std::pair<bool, Index>> st;
   st.push({false, index});
   st.push({true, tree[index].first_child});
 
@@ -50,11 +51,13 @@ static void promote_one_node(CompTree &tree, int index, SplitDirection split_typ
   }
 }
 
-static void promote_one_direction(CompTree &tree, int index, SplitDirection split_type) {
+template <typename Index>
+static void promote_one_direction(BasicCompTree<Index> &tree, Index index, SplitDirection split_type) {
   for (auto c : tree.get_children(index)) promote_one_node(tree, c, split_type);
 }
 
-void promote(CompTree &tree, int prob) {
+template <typename Index>
+void promote(BasicCompTree<Index> &tree, Index prob) {
   TRACE("start: %s", tree.to_string(prob).c_str());
 
   promote_one_direction(tree, prob, SplitDirection::LEFT);
@@ -63,6 +66,10 @@ void promote(CompTree &tree, int prob) {
   TRACE("finish: %s", tree.to_string(prob).c_str());
 }
 
+#define INSTANTIATE(Index) template void promote(BasicCompTree<Index> &, Index);
+MODULAR_FOR_EACH_INDEX_TYPE(INSTANTIATE)
+#undef INSTANTIATE
+
 }  // namespace impl
 }  // namespace compute
 }  // namespace modular
@@ -7,6 +7,9 @@ namespace impl {
 // split directions: left or right
 std::vector<SplitDirection> const DIRS = {SplitDirection::LEFT, SplitDirection::RIGHT};
 
+template <typename Index>
+using Counters = std::vector<BasicRefinementCounters<Index>>;
+
 //================================================================================
 //    Set up
 //================================================================================
@@ -16,38 +19,61 @@ std::vector<SplitDirection> const DIRS = {SplitDirection::LEFT, SplitDirection::
  * @param tree tree
  * @param prob problem root
  */
-static void number_by_comp(CompTree &tree, int prob) {
-  int comp_number = 0;
-  int pivot = tree[prob].data.vertex;
+template <typename Index>
+static void number_by_comp(BasicCompTree<Index> &tree, Index prob) {
+  Index comp_number = 0;
+  Index pivot = tree[prob].data.vertex;
   Operation op_type = Operation::SERIES;
 
-  for (auto c : tree.get_children(prob)) {
+  for (auto c : tree.children(prob)) {
     if (c == pivot) op_type = Operation::PARALLEL;
 
     if (tree[c].data.op_type == op_type) {
-      for (auto x : tree.get_children(c)) {
-        for (auto y : tree.dfs_reverse_preorder_nodes(x)) tree[y].data.comp_number = comp_number;
+      for (auto x : tree.children(c)) {
+        for (auto y : tree.dfs_reverse_preorder(x)) tree[y].data.comp_number = comp_number;
         ++comp_number;
       }
     } else {
-      for (auto y : tree.dfs_reverse_preorder_nodes(c)) tree[y].data.comp_number = comp_number;
+      for (auto y : tree.dfs_reverse_preorder(c)) tree[y].data.comp_number = comp_number;
       ++comp_number;
     }
   }
 }
 
-static void number_by_tree(CompTree &tree, int prob) {
-  int tree_number = 0;
-  for (auto c : tree.get_children(prob)) {
-    for (auto y : tree.dfs_reverse_preorder_nodes(c)) tree[y].data.tree_number = tree_number;
+template <typename Index>
+static void number_by_tree(BasicCompTree<Index> &tree, Index prob) {
+  Index tree_number = 0;
+  for (auto c : tree.children(prob)) {
+    for (auto y : tree.dfs_reverse_preorder(c)) tree[y].data.tree_number = tree_number;
     ++tree_number;
   }
 }
 
+/**
+ * @brief Resets the refinement counters of the nodes in the given problem subtree.
+ */
+template <typename Index>
+static void reset_counters(BasicCompTree<Index> const &tree, Index prob, Counters<Index> &counters) {
+  if (counters.size() < tree.capacity()) counters.resize(tree.capacity());
+  for (auto y : tree.dfs_reverse_preorder(prob)) counters[y] = BasicRefinementCounters<Index>();
+}
+
+/**
+ * @brief Creates a copy of the given node with cleared refinement counters.
+ */
+template <typename Index>
+static Index copy_node(BasicCompTree<Index> &tree, Index index, Counters<Index> &counters) {
+  auto ret = tree.create_node(tree[index].data);
+  if (counters.size() < tree.capacity()) counters.resize(tree.capacity());
+  counters[ret] = BasicRefinementCounters<Index>();
+  return ret;
+}
+
 //================================================================================
 //    Utilities
 //================================================================================
-static bool is_root_operator(CompTree const &tree, int index) {
+template <typename Index>
+static bool is_root_operator(BasicCompTree<Index> const &tree, Index index) {
   return tree[index].is_root() || !tree[tree[index].parent].data.is_operation_node();
 }
 
@@ -62,18 +88,20 @@ static bool is_root_operator(CompTree const &tree, int index) {
  * @param split_type split type
  * @param should_recurse true if it needs to recurse to children
  */
-static void add_split_mark(CompTree &tree, int index, SplitDirection split_type, bool should_recurse, util::Profiler *prof) {
+template <typename Index>
+static void add_split_mark(BasicCompTree<Index> &tree, Counters<Index> &counters, Index index,
+                           SplitDirection split_type, bool should_recurse, util::Profiler *prof) {
   if (!tree[index].data.is_split_marked(split_type)) {
     auto p = tree[index].parent;  // must be a valid node
     // increment the counter if the parent is an operation node
-    if (tree[p].data.is_operation_node()) tree[p].data.increment_num_split_children(split_type);
+    if (tree[p].data.is_operation_node()) counters[p].increment_num_split_children(split_type);
     tree[index].data.set_split_mark(split_type);
   }
 
   if (!should_recurse || tree[index].data.op_type != Operation::PRIME) return;
 
   // split type is already set to all children
-  if (tree[index].number_of_children() == tree[index].data.get_num_split_children(split_type)) {
+  if (tree[index].number_of_children() == counters[index].get_num_split_children(split_type)) {
     // PROF(util::pcount(prof, "add_split_mark(): early return"));
     return;
   }
@@ -81,7 +109,7 @@ static void add_split_mark(CompTree &tree, int index, SplitDirection split_type,
   // PROF(util::pcount(prof, "add_split_mark(): proc child"));
   for (auto c = tree[index].first_child; tree.is_valid(c); c = tree[c].right) {
     if (!tree[c].data.is_split_marked(split_type)) {
-      tree[index].data.increment_num_split_children(split_type);
+      counters[index].increment_num_split_children(split_type);
       tree[c].data.set_split_mark(split_type);
     }
   }
@@ -91,25 +119,28 @@ static void add_split_mark(CompTree &tree, int index, SplitDirection split_type,
  * @brief Adds the given mark to all of this node's ancestors.
  * @param split_type mark to be added
  */
-static void mark_ancestors_by_split(CompTree &tree, int index, SplitDirection split_type, util::Profiler *prof) {
+template <typename Index>
+static void mark_ancestors_by_split(BasicCompTree<Index> &tree, Counters<Index> &counters, Index index,
+                                    SplitDirection split_type, util::Profiler *prof) {
   for (auto p = tree[index].parent;; p = tree[p].parent) {
     if (tree[p].data.is_problem_node()) break;
     if (tree[p].data.is_split_marked(split_type)) {
       // split type is already set to p but we need to take care of its children
-      add_split_mark(tree, p, split_type, true, prof);
+      add_split_mark(tree, counters, p, split_type, true, prof);
       break;
     }
-    add_split_mark(tree, p, split_type, true, prof);
+    add_split_mark(tree, counters, p, split_type, true, prof);
   }
 }
 
 //================================================================================
 //    Get max subtrees
 //================================================================================
-static bool is_parent_fully_charged(CompTree const &tree, int x) {
+template <typename Index>
+static bool is_parent_fully_charged(BasicCompTree<Index> const &tree, Counters<Index> const &counters, Index x) {
   if (is_root_operator(tree, x)) return false;
   auto p = tree[x].parent;
-  return tree[p].number_of_children() == tree[p].data.number_of_marks();
+  return tree[p].number_of_children() == counters[p].number_of_marks();
 }
 
 /**
@@ -119,9 +150,11 @@ static bool is_parent_fully_charged(CompTree const &tree, int x) {
  * @param leaves
  * @return std::list<NodeP>
  */
-static std::vector<int> get_max_subtrees(CompTree &tree, VI const &leaves) {
-  std::vector<int> full_charged(leaves);
-  std::vector<int> charged;
+template <typename Index>
+static std::vector<Index> get_max_subtrees(BasicCompTree<Index> &tree, Counters<Index> &counters,
+                                           typename BasicAlphaLists<Index>::Range leaves) {
+  std::vector<Index> full_charged(leaves.begin(), leaves.end());
+  std::vector<Index> charged;
 
   // charging
   for (std::size_t i = 0; i < full_charged.size(); ++i) {
@@ -129,30 +162,32 @@ static std::vector<int> get_max_subtrees(CompTree &tree, VI const &leaves) {
     if (is_root_operator(tree, x)) continue;
 
     auto p = tree[x].parent;
-    if (!tree[p].data.is_marked()) charged.push_back(p);
-    tree[p].data.add_mark();
+    if (!counters[p].is_marked()) charged.push_back(p);
+    counters[p].add_mark();
 
-    if (tree[p].data.num_marks == tree[p].number_of_children()) {
+    if (counters[p].num_marks == tree[p].number_of_children()) {
       // fully charged
       full_charged.push_back(p);
     }
   }
 
   // discharging
-  std::vector<int> ret;
+  std::vector<Index> ret;
   for (auto x : full_charged) {
-    if (!is_parent_fully_charged(tree, x)) ret.push_back(x);
+    if (!is_parent_fully_charged(tree, counters, x)) ret.push_back(x);
   }
-  for (auto x : charged) tree[x].data.clear_marks();
+  for (auto x : charged) counters[x].clear_marks();
   return ret;
 }
 
 //================================================================================
 //    Group sibling nodes
 //================================================================================
-std::vector<std::pair<int, bool>> group_sibling_nodes(CompTree &tree, std::vector<int> const &nodes) {
-  std::vector<int> parents;
-  std::vector<std::pair<int, bool>> sibling_groups;
+template <typename Index>
+static std::vector<std::pair<Index, bool>> group_sibling_nodes(BasicCompTree<Index> &tree, Counters<Index> &counters,
+                                                               std::vector<Index> const &nodes) {
+  std::vector<Index> parents;
+  std::vector<std::pair<Index, bool>> sibling_groups;
 
   for (auto node : nodes) {
     if (is_root_operator(tree, node)) {
@@ -162,37 +197,36 @@ std::vector<std::pair<int, bool>> group_sibling_nodes(CompTree &tree, std::vecto
       tree.make_first_child(node);
       auto p = tree[node].parent;
 
-      if (!tree[p].data.is_marked()) parents.push_back(p);
-      tree[p].data.add_mark();
+      if (!counters[p].is_marked()) parents.push_back(p);
+      counters[p].add_mark();
     }
   }
 
   for (auto p : parents) {
     // there must be at least one mark
     auto c = tree[p].first_child;
-    auto num_marks = tree[p].data.number_of_marks();
+    auto num_marks = counters[p].number_of_marks();
 
     if (num_marks == 1) {
       // (2) the non-root nodes without siblings
       sibling_groups.push_back({c, false});
     } else {
       // (3) group sibling nodes as children of a new node inserted in their place.
-      auto grouped_children = tree.create_node(tree[p].data);
-      tree[grouped_children].data.clear_marks();
+      auto grouped_children = copy_node(tree, p, counters);
 
       for (auto st : DIRS) {
-        if (tree[grouped_children].data.is_split_marked(st)) tree[p].data.increment_num_split_children(st);
+        if (tree[grouped_children].data.is_split_marked(st)) counters[p].increment_num_split_children(st);
       }
 
       auto c = tree[p].first_child;
-      for (int i = 0; i < num_marks; ++i) {
+      for (Index i = 0; i < num_marks; ++i) {
         auto nxt = tree[c].right;
         tree.move_to(c, grouped_children);
 
         for (auto st : DIRS) {
           if (tree[c].data.is_split_marked(st)) {
-            tree[p].data.decrement_num_split_children(st);
-            tree[grouped_children].data.increment_num_split_children(st);
+            counters[p].decrement_num_split_children(st);
+            counters[grouped_children].increment_num_split_children(st);
           }
         }
         c = nxt;
@@ -201,7 +235,7 @@ std::vector<std::pair<int, bool>> group_sibling_nodes(CompTree &tree, std::vecto
 
       sibling_groups.push_back({grouped_children, tree[grouped_children].data.op_type == Operation::PRIME});
     }
-    tree[p].data.clear_marks();
+    counters[p].clear_marks();
   }
 
   // TRACE("return: %s\n", cstr(sibling_groups));
@@ -211,19 +245,23 @@ std::vector<std::pair<int, bool>> group_sibling_nodes(CompTree &tree, std::vecto
 //================================================================================
 //    Subroutine
 //================================================================================
-static SplitDirection get_split_type(CompTree &tree, int index, VertexID refiner, VertexID pivot) {
+template <typename Index>
+static SplitDirection get_split_type(BasicCompTree<Index> &tree, Index index, Index refiner, Index pivot) {
   auto pivot_tn = tree[pivot].data.tree_number;
   auto refiner_tn = tree[refiner].data.tree_number;
   auto current = tree[index].data.tree_number;
   return current < pivot_tn || refiner_tn < current ? SplitDirection::LEFT : SplitDirection::RIGHT;
 }
 
-static void refine_one_node(CompTree &tree, int index, SplitDirection split_type, bool new_prime, util::Profiler *prof) {
-  TRACE("refining tree=%s, index=%d, split_type=%d, new_prime=%d", tree.to_string(index).c_str(), index, split_type, new_prime);
+template <typename Index>
+static void refine_one_node(BasicCompTree<Index> &tree, Counters<Index> &counters, Index index,
+                            SplitDirection split_type, bool new_prime, util::Profiler *prof) {
+  TRACE("refining tree=%s, index=%d, split_type=%d, new_prime=%d", tree.to_string(index).c_str(),
+        static_cast<int>(index), split_type, new_prime);
   if (is_root_operator(tree, index)) return;
 
   auto p = tree[index].parent;
-  int new_sibling = -1;
+  Index new_sibling = BasicCompTree<Index>::NOT_AVAILABLE;
 
   if (is_root_operator(tree, p)) {
     // PROF(util::pstart(prof, "refine_one_node: root", 0));
@@ -235,7 +273,7 @@ static void refine_one_node(CompTree &tree, int index, SplitDirection split_type
     }
 
     for (auto st : DIRS) {
-      if (tree[index].data.is_split_marked(st)) tree[p].data.decrement_num_split_children(st);
+      if (tree[index].data.is_split_marked(st)) counters[p].decrement_num_split_children(st);
     }
 
     new_sibling = p;
@@ -243,13 +281,13 @@ static void refine_one_node(CompTree &tree, int index, SplitDirection split_type
     if (tree[p].has_only_one_child()) {
       tree.replace_by_children(p);
       tree.remove(p);
-      new_sibling = -1;
+      new_sibling = BasicCompTree<Index>::NOT_AVAILABLE;
     }
     // PROF(util::pstop(prof, "refine_one_node: root", 0));
   } else if (tree[p].data.op_type != Operation::PRIME) {
     // PROF(util::pstart(prof, "refine_one_node: non-root", 0));
     // parent is not a root or PRIME
-    auto replacement = tree.create_node(tree[p].data);
+    auto replacement = copy_node(tree, p, counters);
     tree.replace(p, replacement);
     tree.move_to(index, replacement);
     tree.move_to(p, replacement);
@@ -257,40 +295,43 @@ static void refine_one_node(CompTree &tree, int index, SplitDirection split_type
 
     for (auto st : DIRS) {
       if (tree[index].data.is_split_marked(st)) {
-        tree[p].data.decrement_num_split_children(st);
-        tree[replacement].data.increment_num_split_children(st);
+        counters[p].decrement_num_split_children(st);
+        counters[replacement].increment_num_split_children(st);
       }
-      if (tree[p].data.is_split_marked(st)) tree[replacement].data.increment_num_split_children(st);
+      if (tree[p].data.is_split_marked(st)) counters[replacement].increment_num_split_children(st);
     }
     // PROF(util::pstop(prof, "refine_one_node: non-root", 0));
   }
 
   // PROF(util::pstart(prof, "add_split_mark()", 1));
-  add_split_mark(tree, index, split_type, new_prime, prof);
+  add_split_mark(tree, counters, index, split_type, new_prime, prof);
   // PROF(util::pstop(prof, "add_split_mark()", 1));
 
   // PROF(util::pstart(prof, "mark_ancestors_by_split()"));
-  mark_ancestors_by_split(tree, index, split_type, prof);
+  mark_ancestors_by_split(tree, counters, index, split_type, prof);
   // PROF(util::pstop(prof, "mark_ancestors_by_split()"));
 
-  if (new_sibling >= 0) {
+  if (new_sibling != BasicCompTree<Index>::NOT_AVAILABLE) {
     // non-prime or a new root; safe to set should_recurse=true
     // PROF(util::pstart(prof, "add_split_mark()", 2));
-    add_split_mark(tree, new_sibling, split_type, true, prof);
+    add_split_mark(tree, counters, new_sibling, split_type, true, prof);
     // PROF(util::pstop(prof, "add_split_mark()", 2));
   }
 }
 
-static void refine_with(CompTree &tree, VVV const &alpha_list, VertexID refiner, VertexID pivot, util::Profiler *prof) {
+template <typename Index>
+static void refine_with(BasicCompTree<Index> &tree, Counters<Index> &counters, BasicAlphaLists<Index> const &alpha_list,
+                        Index refiner, Index pivot, util::Profiler *prof) {
   // PROF(util::pstart(prof, "get_max_subtrees()"))
-  auto subtree_roots = get_max_subtrees(tree, alpha_list[refiner]);
+  auto subtree_roots = get_max_subtrees<Index>(tree, counters, alpha_list[refiner]);
   // PROF(util::pstop(prof, "get_max_subtrees()"))
 
   // PROF(util::pstart(prof, "group_sibling_nodes()"))
-  auto sibling_groups = group_sibling_nodes(tree, subtree_roots);
+  auto sibling_groups = group_sibling_nodes(tree, counters, subtree_roots);
   // PROF(util::pstop(prof, "group_sibling_nodes()"))
 
-  TRACE("alpha[%d]: %s", refiner, util::to_string(alpha_list[refiner]).c_str());
+  TRACE("alpha[%d]: %s", static_cast<int>(refiner),
+        util::to_string(alpha_list[refiner].begin(), alpha_list[refiner].end()).c_str());
   TRACE("subtree_roots: %s", util::to_string(subtree_roots).c_str());
   TRACE("sibling_groups: %s, tree=%s", util::to_string(sibling_groups).c_str(), tree.to_string(tree[pivot].parent).c_str());
 
@@ -301,7 +342,7 @@ static void refine_with(CompTree &tree, VVV const &alpha_list, VertexID refiner,
     // PROF(util::pstop(prof, "get_split_type()"))
 
     // PROF(util::pstart(prof, "refine_one_node()"))
-    refine_one_node(tree, x.first, split_type, x.second, prof);
+    refine_one_node(tree, counters, x.first, split_type, x.second, prof);
     // PROF(util::pstop(prof, "refine_one_node()"))
   }
   // PROF(util::pstop(prof, "refine_with: main loop"))
@@ -310,7 +351,9 @@ static void refine_with(CompTree &tree, VVV const &alpha_list, VertexID refiner,
 //================================================================================
 //    Refinement
 //================================================================================
-void refine(CompTree &tree, VVV const &alpha_list, int prob, std::vector<int> &leaves, util::Profiler *prof) {
+template <typename Index>
+void refine(BasicCompTree<Index> &tree, BasicAlphaLists<Index> const &alpha_list, Index prob,
+            std::vector<Index> &leaves, Counters<Index> &counters, util::Profiler *prof) {
   TRACE("start: %s", tree.to_string(prob).c_str());
   // PROF(util::pstart(prof, "refinement:refine()"))
 
@@ -322,10 +365,12 @@ void refine(CompTree &tree, VVV const &alpha_list, int prob, std::vector<int> &l
   number_by_tree(tree, prob);
   // PROF(util::pstop(prof, "refinement:number_by_tree()"))
 
+  reset_counters(tree, prob, counters);
+
   // PROF(util::pstart(prof, "refinement:refine_with()"));
   for (auto v : leaves) {
-    refine_with(tree, alpha_list, v, tree[prob].data.vertex, prof);
-    TRACE("refined at %d: tree=%s", v, tree.to_string(prob).c_str())
+    refine_with(tree, counters, alpha_list, v, tree[prob].data.vertex, prof);
+    TRACE("refined at %d: tree=%s", static_cast<int>(v), tree.to_string(prob).c_str())
   }
   // PROF(util::pstop(prof, "refinement:refine_with()"));
 
@@ -333,6 +378,12 @@ void refine(CompTree &tree, VVV const &alpha_list, int prob, std::vector<int> &l
   TRACE("finish: %s", tree.to_string(prob).c_str());
 }
 
+#define INSTANTIATE(Index)                                                                                  \
+  template void refine(BasicCompTree<Index> &, BasicAlphaLists<Index> const &, Index, std::vector<Index> &, \
+                       Counters<Index> &, util::Profiler *);
+MODULAR_FOR_EACH_INDEX_TYPE(INSTANTIATE)
+#undef INSTANTIATE
+
 }  // namespace impl
 }  // namespace compute
 }  // namespace modular
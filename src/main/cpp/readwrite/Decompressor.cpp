@@ -0,0 +1,199 @@
+#include "Decompressor.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace readwrite {
+Compression detect_compression(char const *begin, char const *end) {
+  auto size = end - begin;
+  auto b = reinterpret_cast<unsigned char const *>(begin);
+  if (size >= 2 && b[0] == 0x1f && b[1] == 0x8b) return Compression::GZIP;
+  if (size >= 4 && b[0] == 0x28 && b[1] == 0xb5 && b[2] == 0x2f && b[3] == 0xfd) return Compression::ZSTD;
+  return Compression::NONE;
+}
+
+Decompressor::Decompressor(char const *begin, char const *end, Compression compression, std::size_t block_size)
+    : begin_(begin), end_(end), compression_(compression), finished_(false), quit_(false), current_(-1), next_(0) {
+  if (compression == Compression::GZIP && !HAVE_ZLIB) {
+    throw std::invalid_argument("Decompressor: gzip input is not supported in this build");
+  }
+  if (compression == Compression::ZSTD && !HAVE_ZSTD) {
+    throw std::invalid_argument("Decompressor: zstd input is not supported in this build");
+  }
+  if (compression == Compression::NONE) throw std::invalid_argument("Decompressor: data is not compressed");
+
+  for (int i = 0; i < 2; ++i) {
+    buffers_[i].resize(block_size);
+    sizes_[i] = 0;
+    filled_[i] = false;
+  }
+  thread_ = std::thread([this]() { run(); });
+}
+
+Decompressor::~Decompressor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void Decompressor::run() {
+  try {
+    if (compression_ == Compression::GZIP) {
+      inflate_gzip();
+    } else {
+      decompress_zstd();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_ = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+  }
+  cv_.notify_all();
+}
+
+bool Decompressor::acquire(int index) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this, index]() { return quit_ || !filled_[index]; });
+  return !quit_;
+}
+
+void Decompressor::publish(int index) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    filled_[index] = true;
+  }
+  cv_.notify_all();
+}
+
+std::pair<char const *, char const *> Decompressor::next() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (current_ >= 0) {
+    // release the block returned last time
+    filled_[current_] = false;
+    current_ = -1;
+    cv_.notify_all();
+  }
+
+  cv_.wait(lock, [this]() { return filled_[next_] || finished_; });
+  if (!filled_[next_]) {
+    if (error_) std::rethrow_exception(error_);
+    return {nullptr, nullptr};
+  }
+
+  current_ = next_;
+  next_ ^= 1;
+  auto p = buffers_[current_].data();
+  return {p, p + sizes_[current_]};
+}
+
+void Decompressor::inflate_gzip() {
+#if HAVE_ZLIB
+  z_stream zs = {};
+  if (inflateInit2(&zs, 15 + 32) != Z_OK) throw std::invalid_argument("Decompressor: failed to initialize zlib");
+  struct Guard {
+    z_stream *zs;
+    ~Guard() { inflateEnd(zs); }
+  } guard = {&zs};
+
+  char const *in = begin_;  // input not yet handed to zlib
+  bool done = false;
+  for (int index = 0; !done && acquire(index); index ^= 1) {
+    auto &buf = buffers_[index];
+    std::size_t filled = 0;
+
+    while (filled < buf.size()) {
+      if (zs.avail_in == 0 && in != end_) {
+        auto chunk = std::min<std::size_t>(end_ - in, UINT_MAX);
+        zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in));
+        zs.avail_in = static_cast<uInt>(chunk);
+        in += chunk;
+      }
+      zs.next_out = reinterpret_cast<Bytef *>(buf.data() + filled);
+      zs.avail_out = static_cast<uInt>(std::min<std::size_t>(buf.size() - filled, UINT_MAX));
+
+      int ret = inflate(&zs, Z_NO_FLUSH);
+      filled = reinterpret_cast<char *>(zs.next_out) - buf.data();
+
+      bool has_input = zs.avail_in > 0 || in != end_;
+      if (ret == Z_STREAM_END) {
+        if (!has_input) {
+          done = true;
+          break;
+        }
+        inflateReset(&zs);  // next gzip member
+      } else if (ret == Z_BUF_ERROR) {
+        if (!has_input) throw std::invalid_argument("Decompressor: truncated gzip data");
+      } else if (ret != Z_OK) {
+        throw std::invalid_argument("Decompressor: corrupt gzip data");
+      }
+    }
+    sizes_[index] = filled;
+    publish(index);
+  }
+#endif
+}
+
+void Decompressor::decompress_zstd() {
+#if HAVE_ZSTD
+  ZSTD_DStream *ds = ZSTD_createDStream();
+  if (!ds) throw std::invalid_argument("Decompressor: failed to initialize zstd");
+  struct Guard {
+    ZSTD_DStream *ds;
+    ~Guard() { ZSTD_freeDStream(ds); }
+  } guard = {ds};
+  ZSTD_initDStream(ds);
+
+  ZSTD_inBuffer in = {begin_, static_cast<std::size_t>(end_ - begin_), 0};
+  std::size_t hint = 1;  // 0 when the last frame is complete
+  bool done = false;
+  for (int index = 0; !done && acquire(index); index ^= 1) {
+    auto &buf = buffers_[index];
+    ZSTD_outBuffer out = {buf.data(), buf.size(), 0};
+
+    while (out.pos < out.size && !(in.pos == in.size && hint == 0)) {
+      auto in_pos = in.pos, out_pos = out.pos;
+      hint = ZSTD_decompressStream(ds, &out, &in);
+      if (ZSTD_isError(hint)) throw std::invalid_argument("Decompressor: corrupt zstd data");
+
+      // no progress without input means that the last frame is incomplete
+      if (in.pos == in.size && hint != 0 && in.pos == in_pos && out.pos == out_pos) {
+        throw std::invalid_argument("Decompressor: truncated zstd data");
+      }
+    }
+    done = in.pos == in.size && hint == 0;
+    sizes_[index] = out.pos;
+    publish(index);
+  }
+#endif
+}
+
+std::vector<char> decompress_all(char const *begin, char const *end, Compression compression) {
+  std::vector<char> ret;
+  Decompressor d(begin, end, compression);
+  for (auto block = d.next(); block.first != block.second; block = d.next()) {
+    ret.insert(ret.end(), block.first, block.second);
+  }
+  return ret;
+}
+
+std::vector<char> decompress_head(char const *begin, char const *end, Compression compression, std::size_t size) {
+  Decompressor d(begin, end, compression, size);
+  auto block = d.next();
+  return std::vector<char>(block.first, block.second);
+}
+}  // namespace readwrite
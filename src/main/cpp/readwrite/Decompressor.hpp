@@ -0,0 +1,126 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace readwrite {
+enum class Compression { NONE, GZIP, ZSTD };
+
+/**
+ * @brief Detects the compression format from the magic bytes.
+ */
+Compression detect_compression(char const *begin, char const *end);
+
+/**
+ * @brief Streaming decompressor for gzip or zstd data in memory.
+ *
+ * A background thread decompresses into one of two buffers while the caller consumes the other,
+ * so decompression overlaps with parsing and the decompressed data is never held as a whole.
+ * Concatenated gzip members and zstd frames are supported.
+ */
+class Decompressor {
+ private:
+  char const *begin_;
+  char const *end_;
+  Compression compression_;
+
+  std::vector<char> buffers_[2];
+  std::size_t sizes_[2];  // number of bytes decompressed into each buffer
+  bool filled_[2];        // true while a buffer waits for or is held by the consumer
+  bool finished_;
+  bool quit_;
+  int current_;  // buffer held by the consumer; -1 if none
+  int next_;     // buffer the consumer reads next
+  std::exception_ptr error_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+
+  void run();
+
+  /**
+   * @brief Waits until the given buffer is free; returns false if the consumer has quit.
+   */
+  bool acquire(int index);
+
+  /**
+   * @brief Hands the given buffer over to the consumer.
+   */
+  void publish(int index);
+
+  void inflate_gzip();
+  void decompress_zstd();
+
+ public:
+  /**
+   * @brief Starts decompression.
+   *
+   * @param begin beginning of the compressed data; must stay valid during decompression
+   * @param end end of the compressed data
+   * @param compression compression format; must not be NONE
+   * @param block_size size of each buffer in bytes
+   * @throw std::invalid_argument if the format is not supported by this build
+   */
+  Decompressor(char const *begin, char const *end, Compression compression, std::size_t block_size = 1 << 22);
+
+  ~Decompressor();
+
+  Decompressor(Decompressor const &) = delete;
+  Decompressor &operator=(Decompressor const &) = delete;
+
+  /**
+   * @brief Returns the next block of decompressed data; valid until the next call.
+   *
+   * @return beginning and end of the block; empty at the end of the data
+   * @throw std::invalid_argument if the data is corrupt
+   */
+  std::pair<char const *, char const *> next();
+
+  /**
+   * @brief Calls f(begin, end) on consecutive non-empty pieces of the decompressed text,
+   * each consisting of whole lines.
+   *
+   * A line split between two blocks is joined in a small carry-over buffer. Only the last piece may lack
+   * the final line break.
+   */
+  template <typename F>
+  void for_each_lines(F f) {
+    std::vector<char> carry;
+    for (auto block = next(); block.first != block.second; block = next()) {
+      char const *p = block.first, *q = block.second;
+      while (q != p && q[-1] != '\n') --q;  // end of the last complete line
+
+      if (q == p) {
+        // no line ends in this block
+        carry.insert(carry.end(), p, block.second);
+        continue;
+      }
+      if (!carry.empty()) {
+        char const *r = p;
+        while (*r != '\n') ++r;  // first line ending
+        carry.insert(carry.end(), p, r + 1);
+        f(carry.data(), carry.data() + carry.size());
+        carry.clear();
+        p = r + 1;
+      }
+      if (p != q) f(p, q);
+      carry.insert(carry.end(), q, block.second);
+    }
+    if (!carry.empty()) f(carry.data(), carry.data() + carry.size());
+  }
+};
+
+/**
+ * @brief Decompresses the whole data into memory.
+ */
+std::vector<char> decompress_all(char const *begin, char const *end, Compression compression);
+
+/**
+ * @brief Decompresses at most the first `size` bytes, e.g. to detect the format of the content.
+ */
+std::vector<char> decompress_head(char const *begin, char const *end, Compression compression, std::size_t size);
+}  // namespace readwrite
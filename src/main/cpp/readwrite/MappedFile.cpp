@@ -0,0 +1,39 @@
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+#include "util/util.hpp"
+
+namespace readwrite {
+MappedFile::MappedFile(char const* path) : data_(nullptr), size_(0) {
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) throw std::invalid_argument(util::format("Failed to open file: %s", path));
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::invalid_argument(util::format("Failed to open file: %s", path));
+  }
+
+  size_ = st.st_size;
+  if (size_ > 0) {
+    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      ::close(fd);
+      throw std::invalid_argument(util::format("Failed to map file: %s", path));
+    }
+    ::madvise(p, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<char const*>(p);
+  }
+  ::close(fd);  // the mapping stays valid
+}
+
+MappedFile::~MappedFile() {
+  if (data_) ::munmap(const_cast<char*>(data_), size_);
+}
+}  // namespace readwrite
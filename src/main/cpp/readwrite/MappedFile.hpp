@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+namespace readwrite {
+/**
+ * @brief Read-only memory mapping of a whole file (RAII).
+ */
+class MappedFile {
+ private:
+  char const* data_;
+  std::size_t size_;
+
+ public:
+  /**
+   * @brief Maps the given file into memory.
+   *
+   * @param path path to the file
+   * @throw std::invalid_argument if the file cannot be opened or mapped
+   */
+  explicit MappedFile(char const* path);
+
+  ~MappedFile();
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  char const* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  char const* begin() const { return data_; }
+  char const* end() const { return data_ + size_; }
+};
+}  // namespace readwrite
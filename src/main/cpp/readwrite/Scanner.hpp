@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+namespace readwrite {
+/**
+ * @brief Minimal scanner for line-oriented text in memory.
+ *
+ * Spaces, tabs and carriage returns separate tokens; '\n' separates lines.
+ */
+class Scanner {
+ private:
+  char const* p_;
+  char const* end_;
+
+  static bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+ public:
+  Scanner(char const* begin, char const* end) : p_(begin), end_(end) {}
+
+  char const* position() const { return p_; }
+
+  bool eof() const { return p_ == end_; }
+
+  /**
+   * @brief Skips blanks within the current line.
+   */
+  void skip_blanks() {
+    while (p_ != end_ && is_blank(*p_)) ++p_;
+  }
+
+  /**
+   * @brief Returns the next non-blank character in the current line, or '\n' at the end of a line or input.
+   */
+  char peek() {
+    skip_blanks();
+    return p_ == end_ ? '\n' : *p_;
+  }
+
+  /**
+   * @brief Skips the next token in the current line.
+   */
+  void skip_token() {
+    skip_blanks();
+    while (p_ != end_ && *p_ != '\n' && !is_blank(*p_)) ++p_;
+  }
+
+  /**
+   * @brief Moves to the beginning of the next line.
+   */
+  void skip_line() {
+    while (p_ != end_ && *p_ != '\n') ++p_;
+    if (p_ != end_) ++p_;
+  }
+
+  /**
+   * @brief Reads a decimal integer in the current line.
+   *
+   * @param x output
+   * @return false if the next token does not start with an integer or it overflows
+   */
+  bool read_int(int64_t& x) {
+    skip_blanks();
+    bool negative = p_ != end_ && *p_ == '-';
+    char const* q = negative ? p_ + 1 : p_;
+    if (q == end_ || *q < '0' || '9' < *q) return false;
+
+    uint64_t y = 0;
+    for (; q != end_ && '0' <= *q && *q <= '9'; ++q) {
+      if (y > (UINT64_C(1) << 63) / 10) return false;
+      y = y * 10 + (*q - '0');
+    }
+    if (y > (UINT64_C(1) << 63) - (negative ? 0 : 1)) return false;
+
+    x = negative ? -static_cast<int64_t>(y - 1) - 1 : static_cast<int64_t>(y);
+    p_ = q;
+    return true;
+  }
+};
+}  // namespace readwrite
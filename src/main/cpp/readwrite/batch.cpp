@@ -0,0 +1,98 @@
+#include "batch.hpp"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "binary.hpp"
+#include "Decompressor.hpp"
+#include "edge_list.hpp"
+#include "load_graph.hpp"
+#include "util/util.hpp"
+
+namespace readwrite {
+std::vector<std::pair<char const *, char const *>> split_blocks(char const *begin, char const *end) {
+  std::vector<std::pair<char const *, char const *>> ret;
+  char const *block = nullptr;  // beginning of the current block
+  for (char const *p = begin; p < end;) {
+    auto q = static_cast<char const *>(std::memchr(p, '\n', end - p));
+    if (!q) q = end;
+
+    bool blank = std::all_of(p, q, [](char c) { return c == ' ' || c == '\t' || c == '\r'; });
+    if (blank && block) {
+      ret.push_back({block, p});
+      block = nullptr;
+    } else if (!blank && !block) {
+      block = p;
+    }
+    p = q + (q < end);
+  }
+  if (block) ret.push_back({block, end});
+  return ret;
+}
+
+GraphBatch::GraphBatch(char const *path) {
+  struct stat st;
+  if (::stat(path, &st) != 0) throw std::invalid_argument(util::format("Failed to open file: %s", path));
+
+  if (S_ISDIR(st.st_mode)) {
+    DIR *dir = ::opendir(path);
+    if (!dir) throw std::invalid_argument(util::format("Failed to open directory: %s", path));
+    while (auto entry = ::readdir(dir)) {
+      if (entry->d_name[0] == '.') continue;
+      auto p = std::string(path) + "/" + entry->d_name;
+      if (::stat(p.c_str(), &st) == 0 && S_ISREG(st.st_mode)) paths_.push_back(p);
+    }
+    ::closedir(dir);
+    std::sort(paths_.begin(), paths_.end());
+    return;
+  }
+
+  file_ = std::make_shared<MappedFile>(path);
+  if (is_binary_graph(file_->begin(), file_->end())) {
+    graphs_ = load_binary_graphs(file_, &labels_);
+    file_.reset();  // kept alive by the graphs
+    return;
+  }
+  set_text(file_->begin(), file_->end());
+}
+
+GraphBatch::GraphBatch(std::istream &is) {
+  auto buf = std::make_shared<std::vector<char>>(read_all(is));
+  if (is_binary_graph(buf->data(), buf->data() + buf->size())) {
+    graphs_ = load_binary_graphs(buf->data(), buf->data() + buf->size(), buf, &labels_);  // kept alive by the graphs
+    return;
+  }
+  text_.swap(*buf);
+  set_text(text_.data(), text_.data() + text_.size());
+}
+
+void GraphBatch::set_text(char const *begin, char const *end) {
+  // blocks are parsed one by one, so compressed text is expanded once up front
+  auto compression = detect_compression(begin, end);
+  if (compression != Compression::NONE) {
+    text_ = decompress_all(begin, end, compression);
+    file_.reset();
+    begin = text_.data();
+    end = text_.data() + text_.size();
+  }
+  blocks_ = split_blocks(begin, end);
+}
+
+ds::graph::CSRGraph GraphBatch::load(std::size_t i, std::vector<int64_t> *labels) const {
+  if (i >= size()) throw std::invalid_argument("GraphBatch: index out of range");
+  if (!paths_.empty()) return load_graph(paths_[i].c_str(), 1, labels);
+
+  if (!graphs_.empty()) {
+    if (labels) *labels = labels_[i];
+    return graphs_[i];
+  }
+
+  auto &b = blocks_[i];
+  if (labels) return parse_edge_list_relabeled(b.first, b.second, *labels);
+  return parse_edge_list_csr(b.first, b.second);
+}
+}  // namespace readwrite
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ds/graph/CSRGraph.hpp"
+#include "readwrite/MappedFile.hpp"
+
+namespace readwrite {
+/**
+ * @brief Splits text into blocks separated by blank lines; lines with only blanks count as blank.
+ *
+ * @return [begin, end) of each non-empty block in order
+ */
+std::vector<std::pair<char const *, char const *>> split_blocks(char const *begin, char const *end);
+
+/**
+ * @brief Collection of graphs loaded one by one, e.g. for modular::decompose_batch().
+ *
+ * A batch is one of the following.
+ * - A directory: every regular file not starting with '.', in the order of names, loaded by load_graph().
+ * - A concatenation of binary graphs (see load_binary_graphs()), mapped into memory at once.
+ * - A text stream of edge lists separated by blank lines (see split_blocks()), possibly compressed.
+ */
+class GraphBatch {
+ private:
+  std::vector<std::string> paths_;
+  std::vector<ds::graph::CSRGraph> graphs_;
+  std::vector<std::vector<int64_t>> labels_;
+  std::shared_ptr<MappedFile> file_;
+  std::vector<char> text_;
+  std::vector<std::pair<char const *, char const *>> blocks_;
+
+  void set_text(char const *begin, char const *end);
+
+ public:
+  /**
+   * @brief Opens a directory, a concatenation of binary graphs or a file of edge lists.
+   *
+   * @throw std::invalid_argument if the path cannot be opened
+   */
+  explicit GraphBatch(char const *path);
+
+  /**
+   * @brief Reads a concatenation of binary graphs or edge lists separated by blank lines from the stream.
+   */
+  explicit GraphBatch(std::istream &is);
+
+  GraphBatch(GraphBatch const &) = delete;
+  GraphBatch &operator=(GraphBatch const &) = delete;
+
+  std::size_t size() const { return paths_.size() + graphs_.size() + blocks_.size(); }
+
+  /**
+   * @brief Loads the i-th graph; safe to call concurrently.
+   *
+   * @param labels if given, edge lists are relabeled to consecutive IDs and this receives the original labels
+   *               (see load_graph()); binary graphs give their stored labels
+   */
+  ds::graph::CSRGraph load(std::size_t i, std::vector<int64_t> *labels = nullptr) const;
+};
+}  // namespace readwrite
@@ -0,0 +1,165 @@
+#include "binary.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "util/util.hpp"
+
+namespace readwrite {
+namespace {
+char const MAGIC[8] = {'M', 'D', 'C', 'S', 'R', 'B', 'I', 'N'};
+
+static_assert(sizeof(BinaryGraphHeader) == 32, "unexpected header size");
+
+bool is_little_endian() {
+  uint32_t x = 1;
+  char c;
+  std::memcpy(&c, &x, 1);
+  return c == 1;
+}
+
+uint64_t align8(uint64_t x) { return (x + 7) & ~static_cast<uint64_t>(7); }
+
+void verify_adjacency(uint64_t n, uint64_t m, ds::graph::CSRGraph::offset_type const *offsets, int const *targets) {
+  if (offsets[0] != 0 || offsets[n] != 2 * m) throw std::invalid_argument("load_binary_graph: invalid offsets");
+  for (uint64_t v = 0; v < n; ++v) {
+    if (offsets[v] > offsets[v + 1]) throw std::invalid_argument("load_binary_graph: invalid offsets");
+    for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+      auto u = targets[i];
+      if (u < 0 || static_cast<uint64_t>(u) >= n || static_cast<uint64_t>(u) == v ||
+          (i > offsets[v] && targets[i - 1] >= u)) {
+        throw std::invalid_argument("load_binary_graph: invalid targets");
+      }
+    }
+  }
+
+  // symmetry: visiting v in increasing order, the arcs into each u come in the order of u's sorted adjacency
+  std::vector<ds::graph::CSRGraph::offset_type> next(offsets, offsets + n);
+  for (uint64_t v = 0; v < n; ++v) {
+    for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+      auto u = targets[i];
+      if (next[u] == offsets[u + 1] || static_cast<uint64_t>(targets[next[u]]) != v) {
+        throw std::invalid_argument("load_binary_graph: asymmetric adjacency");
+      }
+      ++next[u];
+    }
+  }
+}
+
+/**
+ * @brief Uses the graph at the beginning of the given data in place.
+ *
+ * @param size set to the number of bytes taken by the graph
+ */
+ds::graph::CSRGraph load_binary_graph_at(char const *begin, char const *end, std::shared_ptr<void const> const &owner,
+                                         uint64_t &size, std::vector<int64_t> *labels, bool verify) {
+  if (!is_little_endian()) throw std::invalid_argument("load_binary_graph: big-endian hosts are not supported");
+  if (reinterpret_cast<std::uintptr_t>(begin) % 8 != 0) {
+    throw std::invalid_argument("load_binary_graph: misaligned data");
+  }
+  uint64_t available = end - begin;
+  if (!is_binary_graph(begin, end) || available < sizeof(BinaryGraphHeader)) {
+    throw std::invalid_argument("load_binary_graph: not a binary graph");
+  }
+
+  BinaryGraphHeader header;
+  std::memcpy(&header, begin, sizeof(header));
+  if (header.version != BinaryGraphHeader::VERSION) {
+    throw std::invalid_argument(util::format("load_binary_graph: unsupported version: %u", header.version));
+  }
+
+  // check the file size before touching the arrays; guard against overflow with a loose bound
+  uint64_t n = header.n, m = header.m;
+  if (n >= (1ULL << 31) || m >= (1ULL << 60)) throw std::invalid_argument("load_binary_graph: invalid header");
+  bool has_labels = header.flags & BinaryGraphHeader::FLAG_LABELS;
+  uint64_t targets_pos = sizeof(header) + sizeof(uint64_t) * (n + 1);
+  uint64_t labels_pos = align8(targets_pos + sizeof(int) * 2 * m);
+  size = has_labels ? labels_pos + sizeof(int64_t) * n : targets_pos + sizeof(int) * 2 * m;
+  if (available < size) throw std::invalid_argument("load_binary_graph: unexpected file size");
+
+  auto offsets = reinterpret_cast<ds::graph::CSRGraph::offset_type const *>(begin + sizeof(header));
+  auto targets = reinterpret_cast<int const *>(begin + targets_pos);
+  if (verify) verify_adjacency(n, m, offsets, targets);
+
+  if (labels) {
+    labels->clear();
+    if (has_labels) {
+      auto p = reinterpret_cast<int64_t const *>(begin + labels_pos);
+      labels->assign(p, p + n);
+    }
+  }
+  return ds::graph::CSRGraph(n, m, offsets, targets, owner);
+}
+}  // namespace
+
+bool is_binary_graph(char const *begin, char const *end) {
+  return end - begin >= static_cast<std::ptrdiff_t>(sizeof(MAGIC)) && std::memcmp(begin, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void save_binary_graph(char const *path, ds::graph::CSRGraph const &graph, std::vector<int64_t> const *labels) {
+  if (!is_little_endian()) throw std::invalid_argument("save_binary_graph: big-endian hosts are not supported");
+
+  uint64_t n = graph.number_of_nodes(), m = graph.number_of_edges();
+  if (labels && labels->size() != n) throw std::invalid_argument("save_binary_graph: invalid labels");
+
+  BinaryGraphHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = BinaryGraphHeader::VERSION;
+  header.flags = labels ? BinaryGraphHeader::FLAG_LABELS : 0;
+  header.n = n;
+  header.m = m;
+
+  std::ofstream f(path, std::ios::binary);
+  if (f.fail()) throw std::invalid_argument(util::format("Failed to open file: %s", path));
+
+  f.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  f.write(reinterpret_cast<char const *>(graph.offsets()), sizeof(uint64_t) * (n + 1));
+  f.write(reinterpret_cast<char const *>(graph.targets()), sizeof(int) * 2 * m);
+  if (labels) {
+    char const padding[8] = {};
+    uint64_t pos = sizeof(header) + sizeof(uint64_t) * (n + 1) + sizeof(int) * 2 * m;
+    f.write(padding, align8(pos) - pos);
+    f.write(reinterpret_cast<char const *>(labels->data()), sizeof(int64_t) * n);
+  }
+  if (f.fail()) throw std::invalid_argument(util::format("Failed to write file: %s", path));
+}
+
+ds::graph::CSRGraph load_binary_graph(std::shared_ptr<MappedFile> file, std::vector<int64_t> *labels, bool verify) {
+  uint64_t size;
+  auto ret = load_binary_graph_at(file->begin(), file->end(), file, size, labels, verify);
+  if (file->size() != size) throw std::invalid_argument("load_binary_graph: unexpected file size");
+  return ret;
+}
+
+ds::graph::CSRGraph load_binary_graph(char const *path, std::vector<int64_t> *labels, bool verify) {
+  return load_binary_graph(std::make_shared<MappedFile>(path), labels, verify);
+}
+
+std::vector<ds::graph::CSRGraph> load_binary_graphs(char const *begin, char const *end,
+                                                    std::shared_ptr<void const> owner,
+                                                    std::vector<std::vector<int64_t>> *labels, bool verify) {
+  std::vector<ds::graph::CSRGraph> ret;
+  if (labels) labels->clear();
+  for (uint64_t size; begin < end; begin += size) {
+    std::vector<int64_t> *ls = nullptr;
+    if (labels) {
+      labels->emplace_back();
+      ls = &labels->back();
+    }
+    ret.push_back(load_binary_graph_at(begin, end, owner, size, ls, verify));
+  }
+  return ret;
+}
+
+std::vector<ds::graph::CSRGraph> load_binary_graphs(std::shared_ptr<MappedFile> file,
+                                                    std::vector<std::vector<int64_t>> *labels, bool verify) {
+  return load_binary_graphs(file->begin(), file->end(), file, labels, verify);
+}
+
+std::vector<ds::graph::CSRGraph> load_binary_graphs(char const *path, std::vector<std::vector<int64_t>> *labels,
+                                                    bool verify) {
+  return load_binary_graphs(std::make_shared<MappedFile>(path), labels, verify);
+}
+}  // namespace readwrite
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ds/graph/CSRGraph.hpp"
+#include "readwrite/MappedFile.hpp"
+
+namespace readwrite {
+/**
+ * @brief Binary graph format (version 1).
+ *
+ * All integers are little-endian. Every section starts at a multiple of 8 bytes,
+ * so the file can be mapped into memory and used in place.
+ *
+ * | offset            | size         | content                                               |
+ * | :---------------- | :----------- | :---------------------------------------------------- |
+ * | 0                 | 8            | magic "MDCSRBIN"                                      |
+ * | 8                 | 4            | version (uint32)                                      |
+ * | 12                | 4            | flags (uint32); bit 0: has vertex labels              |
+ * | 16                | 8            | n: number of vertices (uint64)                        |
+ * | 24                | 8            | m: number of edges (uint64)                           |
+ * | 32                | 8(n+1)       | CSR offsets (uint64)                                  |
+ * | 32+8(n+1)         | 4(2m)        | CSR targets (int32); sorted and duplicate-free        |
+ * | (8-byte aligned)  | 8n           | vertex labels (int64); only if flags bit 0 is set     |
+ */
+struct BinaryGraphHeader {
+  static constexpr uint32_t VERSION = 1;
+  static constexpr uint32_t FLAG_LABELS = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  uint64_t n;
+  uint64_t m;
+};
+
+/**
+ * @brief Returns true if the given data starts with the magic of the binary graph format.
+ */
+bool is_binary_graph(char const *begin, char const *end);
+
+/**
+ * @brief Writes a graph in the binary format.
+ *
+ * @param path output path
+ * @param graph graph
+ * @param labels optional vertex labels; n entries
+ */
+void save_binary_graph(char const *path, ds::graph::CSRGraph const &graph,
+                       std::vector<int64_t> const *labels = nullptr);
+
+/**
+ * @brief Maps a graph in the binary format into memory; the adjacency is not copied.
+ *
+ * @param file mapped file; kept alive by the returned graph
+ * @param labels optional output for the vertex labels; left empty if the file has none
+ * @param verify checks that the offsets are consistent and every adjacency is sorted, in range and symmetric
+ *               (O(n + m) time)
+ * @throw std::invalid_argument if the file is not a valid binary graph
+ */
+ds::graph::CSRGraph load_binary_graph(std::shared_ptr<MappedFile> file, std::vector<int64_t> *labels = nullptr,
+                                      bool verify = true);
+
+ds::graph::CSRGraph load_binary_graph(char const *path, std::vector<int64_t> *labels = nullptr, bool verify = true);
+
+/**
+ * @brief Maps a concatenation of graphs in the binary format into memory, e.g. one made by `cat a.bin b.bin`.
+ *
+ * Every graph takes a multiple of 8 bytes, so each one in the concatenation stays aligned.
+ *
+ * @param file mapped file; kept alive by the returned graphs
+ * @param labels optional output for the vertex labels of each graph
+ * @return graphs in the order of the file
+ * @throw std::invalid_argument if the file is not a valid concatenation of binary graphs
+ */
+std::vector<ds::graph::CSRGraph> load_binary_graphs(std::shared_ptr<MappedFile> file,
+                                                    std::vector<std::vector<int64_t>> *labels = nullptr,
+                                                    bool verify = true);
+
+/**
+ * @brief Uses a concatenation of graphs in the binary format held in memory, e.g. read from a pipe.
+ *
+ * @param begin beginning of the data; must be 8-byte aligned
+ * @param end end of the data
+ * @param owner object that keeps the data alive; shared by the returned graphs
+ */
+std::vector<ds::graph::CSRGraph> load_binary_graphs(char const *begin, char const *end,
+                                                    std::shared_ptr<void const> owner,
+                                                    std::vector<std::vector<int64_t>> *labels = nullptr,
+                                                    bool verify = true);
+
+std::vector<ds::graph::CSRGraph> load_binary_graphs(char const *path,
+                                                    std::vector<std::vector<int64_t>> *labels = nullptr,
+                                                    bool verify = true);
+}  // namespace readwrite
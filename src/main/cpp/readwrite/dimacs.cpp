@@ -0,0 +1,132 @@
+#include "dimacs.hpp"
+
+#include <climits>
+#include <numeric>
+
+#include "Decompressor.hpp"
+#include "MappedFile.hpp"
+#include "parallel_reader.hpp"
+#include "Scanner.hpp"
+#include "util/util.hpp"
+
+namespace readwrite {
+namespace {
+/**
+ * @brief Reads the problem line `p <descriptor> n m`, skipping comments before it.
+ *
+ * @param sc scanner; moved to the line after the problem line
+ * @param name function name for error messages
+ * @return n and m
+ */
+std::pair<int64_t, int64_t> read_problem_line(Scanner &sc, char const *name) {
+  while (!sc.eof()) {
+    char c = sc.peek();
+    if (c == '\n' || c == 'c') {
+      sc.skip_line();
+      continue;
+    }
+
+    int64_t n, m;
+    if (c != 'p') break;
+    sc.skip_token();
+    sc.skip_token();
+    if (!sc.read_int(n) || !sc.read_int(m) || n < 0 || n >= INT_MAX || m < 0) {
+      throw std::invalid_argument(util::format("%s: invalid problem line", name));
+    }
+    sc.skip_line();
+    return {n, m};
+  }
+  throw std::invalid_argument(util::format("%s: missing problem line", name));
+}
+
+/**
+ * @brief Reads the rest of the line as an edge between 1-indexed vertices.
+ */
+template <typename Emit>
+void read_edge(Scanner &sc, int64_t n, Emit emit, char const *name) {
+  int64_t u, v;
+  if (!sc.read_int(u) || !sc.read_int(v) || u < 1 || v < 1 || u > n || v > n) {
+    throw std::invalid_argument(util::format("%s: invalid edge line", name));
+  }
+  emit(static_cast<int>(u - 1), static_cast<int>(v - 1));
+  sc.skip_line();
+}
+}  // namespace
+
+ds::graph::CSRGraph parse_pace(char const *begin, char const *end, int num_threads) {
+  auto compression = detect_compression(begin, end);
+  if (compression != Compression::NONE) {
+    // the text is read twice, so decompress it into memory first
+    auto text = decompress_all(begin, end, compression);
+    return parse_pace(text.data(), text.data() + text.size(), num_threads);
+  }
+
+  char const *name = "read_pace";
+  Scanner header(begin, end);
+  auto nm = read_problem_line(header, name);
+  int64_t n = nm.first;
+
+  auto bounds = split_lines(header.position(), end, num_threads);
+  int k = static_cast<int>(bounds.size()) - 1;
+  std::vector<int64_t> num_edges(k);
+
+  auto g = build_two_pass(n, k, num_threads, [&](int t, auto emit) {
+    Scanner sc(bounds[t], bounds[t + 1]);
+    num_edges[t] = 0;
+    while (!sc.eof()) {
+      char c = sc.peek();
+      if (c == '\n' || c == 'c') {
+        sc.skip_line();
+        continue;
+      }
+      read_edge(sc, n, emit, name);
+      ++num_edges[t];
+    }
+  });
+
+  if (std::accumulate(num_edges.begin(), num_edges.end(), INT64_C(0)) != nm.second) {
+    throw std::invalid_argument(util::format("%s: inconsistent number of edges", name));
+  }
+  return g;
+}
+
+ds::graph::CSRGraph parse_dimacs(char const *begin, char const *end, int num_threads) {
+  auto compression = detect_compression(begin, end);
+  if (compression != Compression::NONE) {
+    // the text is read twice, so decompress it into memory first
+    auto text = decompress_all(begin, end, compression);
+    return parse_dimacs(text.data(), text.data() + text.size(), num_threads);
+  }
+
+  char const *name = "read_dimacs";
+  Scanner header(begin, end);
+  int64_t n = read_problem_line(header, name).first;
+
+  auto bounds = split_lines(header.position(), end, num_threads);
+  int k = static_cast<int>(bounds.size()) - 1;
+
+  return build_two_pass(n, k, num_threads, [&](int t, auto emit) {
+    Scanner sc(bounds[t], bounds[t + 1]);
+    while (!sc.eof()) {
+      char c = sc.peek();
+      if (c == '\n' || c == 'c') {
+        sc.skip_line();
+        continue;
+      }
+      if (c != 'e') throw std::invalid_argument(util::format("%s: invalid line", name));
+      sc.skip_token();
+      read_edge(sc, n, emit, name);
+    }
+  });
+}
+
+ds::graph::CSRGraph load_pace(char const *path, int num_threads) {
+  MappedFile file(path);
+  return parse_pace(file.begin(), file.end(), num_threads);
+}
+
+ds::graph::CSRGraph load_dimacs(char const *path, int num_threads) {
+  MappedFile file(path);
+  return parse_dimacs(file.begin(), file.end(), num_threads);
+}
+}  // namespace readwrite
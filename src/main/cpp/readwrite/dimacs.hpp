@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ds/graph/CSRGraph.hpp"
+
+namespace readwrite {
+/**
+ * @brief Parses a graph in the PACE format (.gr) in memory.
+ *
+ * The problem line `p <descriptor> n m` (e.g. `p tw 5 4`) precedes the edge lines `u v`, where vertices are
+ * numbered from 1 to n. Lines starting with 'c' and blank lines are skipped.
+ * The edges are read twice, once to size the adjacency and once to fill it, so no edge list is built.
+ * Gzip or zstd input is detected by its magic bytes and decompressed into memory.
+ *
+ * @param begin beginning of the text
+ * @param end end of the text
+ * @param num_threads number of threads; 0 means all hardware threads
+ * @throw std::invalid_argument if a line is malformed or the number of edge lines differs from m
+ */
+ds::graph::CSRGraph parse_pace(char const *begin, char const *end, int num_threads = 1);
+
+/**
+ * @brief Parses a graph in the DIMACS format (.col, .clq) in memory.
+ *
+ * The problem line `p edge n m` (or `p col n m`) precedes the edge lines `e u v`, where vertices are
+ * numbered from 1 to n. Lines starting with 'c' and blank lines are skipped.
+ * m is not checked because published instances disagree on whether it counts both directions.
+ * Gzip or zstd input is detected by its magic bytes and decompressed into memory.
+ *
+ * @param begin beginning of the text
+ * @param end end of the text
+ * @param num_threads number of threads; 0 means all hardware threads
+ * @throw std::invalid_argument if a line is malformed
+ */
+ds::graph::CSRGraph parse_dimacs(char const *begin, char const *end, int num_threads = 1);
+
+/**
+ * @brief Loads a PACE graph by mapping the file into memory.
+ */
+ds::graph::CSRGraph load_pace(char const *path, int num_threads = 1);
+
+/**
+ * @brief Loads a DIMACS graph by mapping the file into memory.
+ */
+ds::graph::CSRGraph load_dimacs(char const *path, int num_threads = 1);
+}  // namespace readwrite
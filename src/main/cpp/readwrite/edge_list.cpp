@@ -1,32 +1,204 @@
-#include <map>
+#include <algorithm>
+#include <climits>
 
+#include "Decompressor.hpp"
 #include "ds/graph/Graph.hpp"
 #include "edge_list.hpp"
+#include "MappedFile.hpp"
+#include "parallel_reader.hpp"
+#include "Scanner.hpp"
+#include "util/parallel.hpp"
 
 namespace readwrite {
-ds::graph::Graph read_edge_list(std::istream &is) {
-  std::vector<std::pair<int, int>> edges;
-  std::vector<int> loops;
-  int max_label = -1;
-
-  for (std::string line; std::getline(is, line);) {
-    if (line.empty()) continue;
-
-    auto ss = std::stringstream(line);
-    int u, v;
-    ss >> u >> v;
-    max_label = std::max(max_label, u);
-    max_label = std::max(max_label, v);
-    edges.push_back({u, v});
+namespace {
+// minimum number of edges per thread for relabeling
+std::size_t const MIN_EDGES_PER_THREAD = 1 << 16;
+
+bool is_valid_label(int64_t x, int) { return 0 <= x && x < INT_MAX; }
+bool is_valid_label(int64_t, int64_t) { return true; }
+
+/**
+ * @brief Parses the lines in [begin, end), calling emit(u, v) for every edge; returns the maximum label.
+ */
+template <typename Label, typename Emit>
+Label parse_lines(char const *begin, char const *end, Emit emit) {
+  Label max_label = -1;
+  Scanner sc(begin, end);
+
+  while (!sc.eof()) {
+    char c = sc.peek();
+    if (c == '\n' || c == '#' || c == '%') {
+      sc.skip_line();
+      continue;
+    }
+
+    int64_t u, v;
+    if (!sc.read_int(u) || !sc.read_int(v) || !is_valid_label(u, Label()) || !is_valid_label(v, Label())) {
+      throw std::invalid_argument("read_edge_list: invalid line");
+    }
+    emit(static_cast<Label>(u), static_cast<Label>(v));
+    max_label = std::max(max_label, static_cast<Label>(std::max(u, v)));
+    sc.skip_line();
+  }
+  return max_label;
+}
+
+/**
+ * @brief Parses an edge list in chunks; returns the maximum label and the edges.
+ */
+template <typename Label>
+std::pair<Label, std::vector<std::pair<Label, Label>>> parse_chunks(char const *begin, char const *end,
+                                                                    int num_threads) {
+  auto compression = detect_compression(begin, end);
+  if (compression != Compression::NONE) {
+    // parse each piece of lines while the next one is decompressed
+    Label max_label = -1;
+    std::vector<std::pair<Label, Label>> edges;
+    Decompressor d(begin, end, compression);
+    d.for_each_lines([&](char const *b, char const *e) {
+      auto emit = [&edges](Label u, Label v) { edges.push_back({u, v}); };
+      max_label = std::max(max_label, parse_lines<Label>(b, e, emit));
+    });
+    return {max_label, std::move(edges)};
+  }
+
+  // align chunk boundaries to the beginning of lines
+  auto bounds = split_lines(begin, end, num_threads);
+  int k = static_cast<int>(bounds.size()) - 1;
+
+  std::vector<std::vector<std::pair<Label, Label>>> parts(k);
+  std::vector<Label> max_labels(k);
+  util::parallel_for(k, [&](int t) {
+    parts[t].reserve((bounds[t + 1] - bounds[t]) / 8);
+    auto &part = parts[t];
+    max_labels[t] = parse_lines<Label>(bounds[t], bounds[t + 1], [&part](Label u, Label v) { part.push_back({u, v}); });
+  });
+
+  Label max_label = *std::max_element(max_labels.begin(), max_labels.end());
+  if (k == 1) return {max_label, std::move(parts[0])};
+
+  std::size_t m = 0;
+  for (auto &p : parts) m += p.size();
+  std::vector<std::pair<Label, Label>> edges;
+  edges.reserve(m);
+  for (auto &p : parts) {
+    edges.insert(edges.end(), p.begin(), p.end());
+    std::vector<std::pair<Label, Label>>().swap(p);
+  }
+  return {max_label, std::move(edges)};
+}
+
+/**
+ * @brief Calls build(k, parse_chunk) with a parser of k chunks of the text for a two-pass builder.
+ *
+ * Compressed input is a single chunk, which is decompressed again on every pass instead of being kept.
+ */
+template <typename Build>
+auto parse_two_pass(char const *begin, char const *end, int num_threads, Build build) {
+  auto compression = detect_compression(begin, end);
+  if (compression != Compression::NONE) {
+    return build(1, [begin, end, compression](int, auto emit) {
+      Decompressor d(begin, end, compression);
+      d.for_each_lines([&emit](char const *b, char const *e) { parse_lines<int>(b, e, emit); });
+    });
+  }
+
+  auto bounds = split_lines(begin, end, num_threads);
+  int k = static_cast<int>(bounds.size()) - 1;
+  return build(k, [&bounds](int t, auto emit) { parse_lines<int>(bounds[t], bounds[t + 1], emit); });
+}
+
+ds::graph::Graph parse_edge_list_graph(char const *begin, char const *end, int num_threads) {
+  return parse_two_pass(begin, end, num_threads, [num_threads](int k, auto parse_chunk) {
+    return build_graph_two_pass(k, num_threads, parse_chunk);
+  });
+}
+}  // namespace
+
+std::pair<int, std::vector<std::pair<int, int>>> parse_edge_list(char const *begin, char const *end, int num_threads) {
+  auto p = parse_chunks<int>(begin, end, num_threads);
+  return {p.first + 1, std::move(p.second)};
+}
+
+ds::graph::CSRGraph parse_edge_list_csr(char const *begin, char const *end, int num_threads) {
+  return parse_two_pass(begin, end, num_threads, [num_threads](int k, auto parse_chunk) {
+    return build_two_pass(k, num_threads, parse_chunk);
+  });
+}
+
+ds::graph::CSRGraph parse_edge_list_relabeled(char const *begin, char const *end, std::vector<int64_t> &labels,
+                                              int num_threads) {
+  auto edges = parse_chunks<int64_t>(begin, end, num_threads).second;
+  std::size_t m = edges.size();
+
+  // sort-unique the labels; the new ID of a label is its rank
+  labels.clear();
+  labels.reserve(2 * m);
+  for (auto &e : edges) {
+    labels.push_back(e.first);
+    labels.push_back(e.second);
+  }
+  std::sort(labels.begin(), labels.end());
+  labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+  labels.shrink_to_fit();
+  if (labels.size() >= INT_MAX) throw std::invalid_argument("read_edge_list: too many vertices");
+
+  std::vector<std::pair<int, int>> relabeled(m);
+  auto rank = [&labels](int64_t x) {
+    return static_cast<int>(std::lower_bound(labels.begin(), labels.end(), x) - labels.begin());
+  };
+  int k = static_cast<int>(std::max<std::size_t>(
+      1, std::min<std::size_t>(util::resolve_num_threads(num_threads), m / MIN_EDGES_PER_THREAD)));
+  util::parallel_for(k, [&](int t) {
+    for (std::size_t i = util::chunk_begin(m, t, k); i < util::chunk_begin(m, t + 1, k); ++i) {
+      relabeled[i] = {rank(edges[i].first), rank(edges[i].second)};
+    }
+  });
+  std::vector<std::pair<int64_t, int64_t>>().swap(edges);
+
+  return ds::graph::CSRGraph(labels.size(), relabeled, num_threads);
+}
+
+std::vector<char> read_all(std::istream &is) {
+  std::vector<char> buf;
+  std::size_t const block = 1 << 20;
+  for (;;) {
+    std::size_t sz = buf.size();
+    buf.resize(sz + block);
+    is.read(buf.data() + sz, block);
+    buf.resize(sz + is.gcount());
+    if (!is) break;
   }
+  return buf;
+}
+
+ds::graph::Graph read_edge_list(std::istream &is, int num_threads) {
+  auto buf = read_all(is);
+  return parse_edge_list_graph(buf.data(), buf.data() + buf.size(), num_threads);
+}
+
+ds::graph::CSRGraph read_edge_list_csr(std::istream &is, int num_threads) {
+  auto buf = read_all(is);
+  return parse_edge_list_csr(buf.data(), buf.data() + buf.size(), num_threads);
+}
+
+ds::graph::CSRGraph read_edge_list_relabeled(std::istream &is, std::vector<int64_t> &labels, int num_threads) {
+  auto buf = read_all(is);
+  return parse_edge_list_relabeled(buf.data(), buf.data() + buf.size(), labels, num_threads);
+}
+
+ds::graph::Graph load_edge_list(char const *path, int num_threads) {
+  MappedFile file(path);
+  return parse_edge_list_graph(file.begin(), file.end(), num_threads);
+}
 
-  int n = max_label + 1;
-  return ds::graph::Graph(n, edges);
+ds::graph::CSRGraph load_edge_list_csr(char const *path, int num_threads) {
+  MappedFile file(path);
+  return parse_edge_list_csr(file.begin(), file.end(), num_threads);
 }
 
-ds::graph::Graph load_edge_list(char const *path) {
-  std::ifstream f(path);
-  if (f.fail()) throw std::invalid_argument(util::format("Failed to open file: %s", path));
-  return read_edge_list(f);
+ds::graph::CSRGraph load_edge_list_relabeled(char const *path, std::vector<int64_t> &labels, int num_threads) {
+  MappedFile file(path);
+  return parse_edge_list_relabeled(file.begin(), file.end(), labels, num_threads);
 }
 }  // namespace readwrite
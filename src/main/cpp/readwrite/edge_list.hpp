@@ -1,9 +1,78 @@
 #pragma once
+#include <cstdint>
 #include <fstream>
 #include <sstream>
+#include <vector>
+
+#include "ds/graph/CSRGraph.hpp"
+#include "ds/graph/Graph.hpp"
 
 namespace readwrite {
-ds::graph::Graph read_edge_list(std::istream &is);
+/**
+ * @brief Parses an edge list in memory.
+ *
+ * Each line has two non-negative integer labels separated by blanks; the rest of the line is ignored.
+ * Blank lines and comment lines starting with '#' or '%' are skipped, and CRLF line endings are accepted.
+ * The input is split into chunks at line boundaries and parsed in parallel.
+ * Gzip or zstd input is detected by its magic bytes and parsed while it is decompressed on another thread.
+ *
+ * @param begin beginning of the text
+ * @param end end of the text
+ * @param num_threads number of threads; 0 means all hardware threads
+ * @return number of vertices (the maximum label plus one) and edges
+ * @throw std::invalid_argument if a line is malformed
+ */
+std::pair<int, std::vector<std::pair<int, int>>> parse_edge_list(char const *begin, char const *end,
+                                                                 int num_threads = 1);
+
+/**
+ * @brief Parses an edge list in memory directly into the solver's graph.
+ *
+ * The text is read twice: once to count degrees and once to scatter the edges into the final adjacency,
+ * so no edge list is materialized and, besides the text, peak memory stays around one adjacency array.
+ * Compressed input is decompressed once for each pass instead of being kept, trading CPU time for the same bound.
+ * The format is the same as parse_edge_list().
+ */
+ds::graph::CSRGraph parse_edge_list_csr(char const *begin, char const *end, int num_threads = 1);
+
+/**
+ * @brief Parses an edge list with arbitrary 64-bit integer labels and relabels the vertices to 0, ..., n - 1.
+ *
+ * The labels are compacted by sort-unique, so n is the number of distinct labels rather than the maximum label
+ * plus one, and vertices are numbered in increasing order of labels.
+ *
+ * @param begin beginning of the text
+ * @param end end of the text
+ * @param labels output; labels[v] is the original label of vertex v
+ * @param num_threads number of threads; 0 means all hardware threads
+ * @throw std::invalid_argument if a line is malformed
+ */
+ds::graph::CSRGraph parse_edge_list_relabeled(char const *begin, char const *end, std::vector<int64_t> &labels,
+                                              int num_threads = 1);
+
+/**
+ * @brief Reads the rest of the stream into one buffer, growing it in 1 MiB blocks.
+ */
+std::vector<char> read_all(std::istream &is);
+
+/**
+ * @brief Reads an edge list into a graph whose representation is chosen by ds::graph::Graph::prefers_dense().
+ *
+ * Like parse_edge_list_csr(), the text is read twice, but the arcs go straight into the adjacency sets,
+ * so peak memory stays around one graph instead of a CSR graph plus its copy.
+ */
+ds::graph::Graph read_edge_list(std::istream &is, int num_threads = 1);
+
+ds::graph::CSRGraph read_edge_list_csr(std::istream &is, int num_threads = 1);
+
+ds::graph::CSRGraph read_edge_list_relabeled(std::istream &is, std::vector<int64_t> &labels, int num_threads = 1);
+
+/**
+ * @brief Loads an edge list by mapping the file into memory; see read_edge_list().
+ */
+ds::graph::Graph load_edge_list(char const *path, int num_threads = 1);
+
+ds::graph::CSRGraph load_edge_list_csr(char const *path, int num_threads = 1);
 
-ds::graph::Graph load_edge_list(char const *path);
+ds::graph::CSRGraph load_edge_list_relabeled(char const *path, std::vector<int64_t> &labels, int num_threads = 1);
 }  // namespace readwrite
@@ -0,0 +1,72 @@
+#include "load_graph.hpp"
+
+#include <cstring>
+#include <string>
+
+#include "binary.hpp"
+#include "Decompressor.hpp"
+#include "dimacs.hpp"
+#include "edge_list.hpp"
+#include "MappedFile.hpp"
+#include "metis.hpp"
+#include "Scanner.hpp"
+
+namespace readwrite {
+namespace {
+bool ends_with(char const *path, std::string const &suffix) {
+  std::size_t n = std::strlen(path);
+  return n >= suffix.size() && suffix.compare(path + n - suffix.size()) == 0;
+}
+
+/**
+ * @brief Returns true if the path has the given extension, possibly followed by .gz or .zst.
+ */
+bool has_extension(char const *path, std::string const &ext) {
+  return ends_with(path, ext) || ends_with(path, ext + ".gz") || ends_with(path, ext + ".zst");
+}
+
+/**
+ * @brief Returns the descriptor in the problem line `p <descriptor> ...`, or an empty string if the text
+ * does not start with one, skipping blank lines and 'c' comments.
+ */
+std::string problem_descriptor(char const *begin, char const *end) {
+  Scanner sc(begin, end);
+  while (!sc.eof() && (sc.peek() == '\n' || sc.peek() == 'c')) sc.skip_line();
+  if (sc.peek() != 'p') return "";
+
+  sc.skip_token();
+  sc.skip_blanks();
+  char const *p = sc.position();
+  sc.skip_token();
+  return std::string(p, sc.position());
+}
+}  // namespace
+
+ds::graph::CSRGraph load_graph(char const *path, int num_threads, std::vector<int64_t> *labels) {
+  auto file = std::make_shared<MappedFile>(path);
+  if (is_binary_graph(file->begin(), file->end())) return load_binary_graph(std::move(file), labels);
+  if (labels) labels->clear();
+
+  // detect the format from the beginning of the (decompressed) text
+  auto compression = detect_compression(file->begin(), file->end());
+  std::vector<char> head;
+  if (compression != Compression::NONE) head = decompress_head(file->begin(), file->end(), compression, 1 << 16);
+  char const *head_begin = compression == Compression::NONE ? file->begin() : head.data();
+  char const *head_end = compression == Compression::NONE ? file->end() : head.data() + head.size();
+  if (is_binary_graph(head_begin, head_end)) {
+    throw std::invalid_argument("load_graph: compressed binary graphs are not supported");
+  }
+
+  // the parsers decompress the input by themselves
+  if (has_extension(path, ".graph") || has_extension(path, ".metis")) {
+    return parse_metis(file->begin(), file->end(), num_threads);
+  }
+
+  auto descriptor = problem_descriptor(head_begin, head_end);
+  if (descriptor == "edge" || descriptor == "col") return parse_dimacs(file->begin(), file->end(), num_threads);
+  if (!descriptor.empty()) return parse_pace(file->begin(), file->end(), num_threads);
+
+  if (labels) return parse_edge_list_relabeled(file->begin(), file->end(), *labels, num_threads);
+  return parse_edge_list_csr(file->begin(), file->end(), num_threads);
+}
+}  // namespace readwrite
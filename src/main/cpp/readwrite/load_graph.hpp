@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ds/graph/CSRGraph.hpp"
+
+namespace readwrite {
+/**
+ * @brief Loads a graph file, detecting its format from the content.
+ *
+ * Supported formats: binary graph (see binary.hpp), PACE and DIMACS (see dimacs.hpp), METIS (see metis.hpp)
+ * and edge list (see edge_list.hpp). METIS files are recognized by the extension .graph or .metis.
+ * Text formats may be compressed with gzip or zstd.
+ *
+ * @param path path to the file
+ * @param num_threads number of threads used for parsing; 0 means all hardware threads
+ * @param labels if given, edge lists are relabeled to consecutive IDs (see load_edge_list_relabeled()) and
+ *               this receives the original labels; it is left empty if the vertices keep their IDs
+ */
+ds::graph::CSRGraph load_graph(char const *path, int num_threads = 1, std::vector<int64_t> *labels = nullptr);
+}  // namespace readwrite
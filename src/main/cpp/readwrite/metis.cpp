@@ -0,0 +1,99 @@
+#include "metis.hpp"
+
+#include <climits>
+#include <numeric>
+
+#include "Decompressor.hpp"
+#include "MappedFile.hpp"
+#include "parallel_reader.hpp"
+#include "Scanner.hpp"
+#include "util/util.hpp"
+
+namespace readwrite {
+ds::graph::CSRGraph parse_metis(char const *begin, char const *end, int num_threads) {
+  auto compression = detect_compression(begin, end);
+  if (compression != Compression::NONE) {
+    // the text is read twice, so decompress it into memory first
+    auto text = decompress_all(begin, end, compression);
+    return parse_metis(text.data(), text.data() + text.size(), num_threads);
+  }
+
+  Scanner header(begin, end);
+  while (!header.eof() && (header.peek() == '%' || header.peek() == '\n')) header.skip_line();
+
+  int64_t n, m, fmt = 0, ncon = 1;
+  if (!header.read_int(n) || !header.read_int(m) || n < 0 || n >= INT_MAX || m < 0) {
+    throw std::invalid_argument("read_metis: invalid header");
+  }
+  if (header.read_int(fmt)) header.read_int(ncon);
+  if (fmt < 0 || fmt > 111 || fmt % 10 > 1 || fmt / 10 % 10 > 1 || ncon < 1 || ncon > INT_MAX) {
+    throw std::invalid_argument("read_metis: invalid header");
+  }
+  header.skip_line();
+
+  bool has_edge_weights = fmt % 10;
+  int64_t num_skipped = (fmt / 100) + (fmt / 10 % 10) * ncon;  // vertex size and vertex weights
+
+  auto bounds = split_lines(header.position(), end, num_threads);
+  int k = static_cast<int>(bounds.size()) - 1;
+
+  // count vertex lines to find the first vertex of each chunk
+  std::vector<int64_t> first_vertex(k + 1, 0);
+  util::parallel_for(k, [&](int t) {
+    Scanner sc(bounds[t], bounds[t + 1]);
+    int64_t lines = 0;
+    for (; !sc.eof(); sc.skip_line()) {
+      if (sc.peek() != '%') ++lines;
+    }
+    first_vertex[t + 1] = lines;
+  });
+  std::partial_sum(first_vertex.begin(), first_vertex.end(), first_vertex.begin());
+  if (first_vertex[k] < n) throw std::invalid_argument("read_metis: too few vertex lines");
+
+  // number of entries (v, u) with v < u and with v > u, respectively
+  std::vector<int64_t> upper(k), lower(k);
+
+  auto g = build_two_pass(n, k, num_threads, [&](int t, auto emit) {
+    Scanner sc(bounds[t], bounds[t + 1]);
+    int64_t v = first_vertex[t], x;
+    upper[t] = lower[t] = 0;
+
+    for (; !sc.eof(); sc.skip_line()) {
+      if (sc.peek() == '%') continue;
+      if (v >= n) {
+        if (sc.peek() != '\n') throw std::invalid_argument("read_metis: too many vertex lines");
+        continue;  // trailing blank lines
+      }
+
+      for (int64_t i = 0; i < num_skipped; ++i) {
+        if (!sc.read_int(x)) throw std::invalid_argument("read_metis: invalid vertex line");
+      }
+      while (sc.peek() != '\n') {
+        int64_t u;
+        if (!sc.read_int(u) || u < 1 || u > n || (has_edge_weights && !sc.read_int(x))) {
+          throw std::invalid_argument("read_metis: invalid vertex line");
+        }
+        --u;
+        if (v < u) {
+          emit(static_cast<int>(v), static_cast<int>(u));
+          ++upper[t];
+        } else if (u < v) {
+          ++lower[t];
+        }
+      }
+      ++v;
+    }
+  });
+
+  if (std::accumulate(upper.begin(), upper.end(), INT64_C(0)) != m ||
+      std::accumulate(lower.begin(), lower.end(), INT64_C(0)) != m) {
+    throw std::invalid_argument("read_metis: adjacency is inconsistent with the number of edges");
+  }
+  return g;
+}
+
+ds::graph::CSRGraph load_metis(char const *path, int num_threads) {
+  MappedFile file(path);
+  return parse_metis(file.begin(), file.end(), num_threads);
+}
+}  // namespace readwrite
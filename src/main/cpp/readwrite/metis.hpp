@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ds/graph/CSRGraph.hpp"
+
+namespace readwrite {
+/**
+ * @brief Parses a graph in the METIS format (.graph) in memory.
+ *
+ * The header `n m [fmt [ncon]]` is followed by exactly n lines, where the i-th line lists the neighbors of
+ * vertex i, numbered from 1 to n; a blank line is an isolated vertex. Vertex sizes, vertex weights and
+ * edge weights declared by fmt are skipped. Lines starting with '%' are comments.
+ * Each edge is taken from the line of its smaller endpoint, so the adjacency must be symmetric as the format requires.
+ * Gzip or zstd input is detected by its magic bytes and decompressed into memory.
+ *
+ * @param begin beginning of the text
+ * @param end end of the text
+ * @param num_threads number of threads; 0 means all hardware threads
+ * @throw std::invalid_argument if a line is malformed or the adjacency is inconsistent with m
+ */
+ds::graph::CSRGraph parse_metis(char const *begin, char const *end, int num_threads = 1);
+
+/**
+ * @brief Loads a METIS graph by mapping the file into memory.
+ */
+ds::graph::CSRGraph load_metis(char const *path, int num_threads = 1);
+}  // namespace readwrite
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "ds/graph/CSRGraph.hpp"
+#include "ds/graph/Graph.hpp"
+#include "util/parallel.hpp"
+
+namespace readwrite {
+/**
+ * @brief Splits text into at most `num_threads` chunks at line boundaries.
+ *
+ * Inputs smaller than 1 MiB per thread use fewer chunks.
+ *
+ * @return chunk boundaries; the first is `begin` and the last is `end`
+ */
+inline std::vector<char const *> split_lines(char const *begin, char const *end, int num_threads) {
+  std::size_t const min_bytes_per_thread = 1 << 20;
+  std::size_t size = end - begin;
+  int k = static_cast<int>(std::max<std::size_t>(
+      1, std::min<std::size_t>(util::resolve_num_threads(num_threads), size / min_bytes_per_thread)));
+
+  std::vector<char const *> bounds(k + 1, end);
+  bounds[0] = begin;
+  for (int t = 1; t < k; ++t) {
+    char const *p = std::max(bounds[t - 1], begin + util::chunk_begin(size, t, k));
+    while (p != end && p[-1] != '\n') ++p;
+    bounds[t] = p;
+  }
+  return bounds;
+}
+
+namespace detail {
+/**
+ * @brief Second pass of build_two_pass().
+ *
+ * @param pos pos[t][v] is the number of arcs for v in chunk t; consumed
+ */
+template <typename ParseChunk>
+ds::graph::CSRGraph fill_two_pass(std::size_t n, int k, int num_threads,
+                                  std::vector<std::vector<ds::graph::CSRGraph::offset_type>> &pos,
+                                  ParseChunk parse_chunk) {
+  typedef ds::graph::CSRGraph::offset_type offset_type;
+
+  // turn the counts into write positions
+  std::vector<offset_type> offsets(n + 1, 0);
+  for (std::size_t v = 0; v < n; ++v) {
+    auto p = offsets[v];
+    for (int t = 0; t < k; ++t) {
+      auto c = pos[t][v];
+      pos[t][v] = p;
+      p += c;
+    }
+    offsets[v + 1] = p;
+  }
+
+  std::vector<int> raw(offsets[n]);
+  util::parallel_for(k, [&](int t) {
+    auto &p = pos[t];
+    parse_chunk(t, [&p, &raw](int u, int v) {
+      if (u == v) return;
+      raw[p[u]++] = v;
+      raw[p[v]++] = u;
+    });
+  });
+  std::vector<std::vector<offset_type>>().swap(pos);
+
+  ds::graph::GraphBuilder::sort_adjacency_in_place(n, num_threads, offsets, raw);
+  return ds::graph::CSRGraph(std::move(offsets), std::move(raw));
+}
+}  // namespace detail
+
+/**
+ * @brief Builds a graph by reading its edges twice, without an intermediate edge list.
+ *
+ * The first pass counts degrees and the second scatters the arcs into the final adjacency,
+ * which is then sorted in place; besides the text, peak memory stays around one adjacency array
+ * and O(n * k) counters.
+ * `parse_chunk(t, emit)` must call `emit(u, v)` for every edge in chunk t, identically in both passes,
+ * and throw std::invalid_argument for labels outside [0, n).
+ *
+ * @param n number of vertices
+ * @param k number of chunks, parsed concurrently
+ * @param num_threads number of threads used for sorting adjacency
+ * @param parse_chunk chunk parser
+ */
+template <typename ParseChunk>
+ds::graph::CSRGraph build_two_pass(std::size_t n, int k, int num_threads, ParseChunk parse_chunk) {
+  std::vector<std::vector<ds::graph::CSRGraph::offset_type>> pos(k, std::vector<ds::graph::CSRGraph::offset_type>(n));
+  util::parallel_for(k, [&](int t) {
+    auto &cnt = pos[t];
+    parse_chunk(t, [&cnt](int u, int v) {
+      if (u == v) return;  // drop loops
+      ++cnt[u];
+      ++cnt[v];
+    });
+  });
+  return detail::fill_two_pass(n, k, num_threads, pos, parse_chunk);
+}
+
+namespace detail {
+/**
+ * @brief First pass of build_two_pass() when the number of vertices is not known in advance.
+ *
+ * @param pos output; pos[t][v] is the number of arcs for v in chunk t
+ * @return number of vertices, the maximum label plus one
+ */
+template <typename ParseChunk>
+std::size_t count_two_pass(int k, std::vector<std::vector<ds::graph::CSRGraph::offset_type>> &pos,
+                           ParseChunk parse_chunk) {
+  pos.assign(k, {});
+  std::vector<std::size_t> sizes(k, 0);  // maximum label plus one in each chunk
+  util::parallel_for(k, [&](int t) {
+    auto &cnt = pos[t];
+    auto &size = sizes[t];
+    parse_chunk(t, [&cnt, &size](int u, int v) {
+      size = std::max(size, static_cast<std::size_t>(std::max(u, v)) + 1);
+      if (size > cnt.size()) cnt.resize(std::max(size, cnt.size() * 2));  // amortized growth
+      if (u == v) return;
+      ++cnt[u];
+      ++cnt[v];
+    });
+  });
+
+  std::size_t n = *std::max_element(sizes.begin(), sizes.end());
+  for (auto &cnt : pos) {
+    cnt.resize(n);
+    cnt.shrink_to_fit();
+  }
+  return n;
+}
+}  // namespace detail
+
+/**
+ * @brief Builds a graph by reading its edges twice when the number of vertices is not known in advance.
+ *
+ * The number of vertices is the maximum label plus one. `parse_chunk` must reject negative labels.
+ */
+template <typename ParseChunk>
+ds::graph::CSRGraph build_two_pass(int k, int num_threads, ParseChunk parse_chunk) {
+  std::vector<std::vector<ds::graph::CSRGraph::offset_type>> pos;
+  std::size_t n = detail::count_two_pass(k, pos, parse_chunk);
+  return detail::fill_two_pass(n, k, num_threads, pos, parse_chunk);
+}
+
+/**
+ * @brief Builds a ds::graph::Graph by reading its edges twice, like build_two_pass().
+ *
+ * The arcs are scattered straight into per-vertex lists of their final size, which are sorted in place and
+ * handed over to the graph, so no CSR arrays are built on the way.
+ */
+template <typename ParseChunk>
+ds::graph::Graph build_graph_two_pass(int k, int num_threads, ParseChunk parse_chunk) {
+  std::vector<std::vector<ds::graph::CSRGraph::offset_type>> pos;
+  std::size_t n = detail::count_two_pass(k, pos, parse_chunk);
+
+  // turn the counts into write positions within the list of each vertex
+  std::vector<std::vector<int>> adj(n);
+  for (std::size_t v = 0; v < n; ++v) {
+    ds::graph::CSRGraph::offset_type p = 0;
+    for (int t = 0; t < k; ++t) {
+      auto c = pos[t][v];
+      pos[t][v] = p;
+      p += c;
+    }
+    adj[v].resize(p);
+  }
+
+  util::parallel_for(k, [&](int t) {
+    auto &p = pos[t];
+    parse_chunk(t, [&p, &adj](int u, int v) {
+      if (u == v) return;
+      adj[u][p[u]++] = v;
+      adj[v][p[v]++] = u;
+    });
+  });
+  std::vector<std::vector<ds::graph::CSRGraph::offset_type>>().swap(pos);
+
+  int s = static_cast<int>(std::min<std::size_t>(util::resolve_num_threads(num_threads), std::max<std::size_t>(n, 1)));
+  util::parallel_for(s, [&](int t) {
+    for (auto v = util::chunk_begin(n, t, s); v < util::chunk_begin(n, t + 1, s); ++v) {
+      std::sort(adj[v].begin(), adj[v].end());
+      adj[v].erase(std::unique(adj[v].begin(), adj[v].end()), adj[v].end());
+    }
+  });
+  return ds::graph::Graph(std::move(adj));
+}
+}  // namespace readwrite
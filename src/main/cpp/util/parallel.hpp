@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util {
+/**
+ * @brief Resolves the number of worker threads.
+ *
+ * @param num_threads requested number of threads; 0 or negative means all hardware threads
+ * @return positive number of threads
+ */
+inline int resolve_num_threads(int num_threads) {
+  if (num_threads > 0) return num_threads;
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief Returns the beginning of the i-th of k nearly equal chunks of [0, size).
+ */
+inline std::size_t chunk_begin(std::size_t size, int i, int k) {
+  return size / k * i + std::min<std::size_t>(size % k, i);
+}
+
+/**
+ * @brief Runs f(0), f(1), ..., f(num_threads - 1) concurrently and waits for all of them.
+ *
+ * f(0) runs on the calling thread. The first exception thrown by any of them is rethrown.
+ */
+template <typename F>
+void parallel_for(int num_threads, F f) {
+  if (num_threads <= 1) {
+    f(0);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; ++t) {
+    threads.emplace_back([&f, &errors, t]() {
+      try {
+        f(t);
+      } catch (...) { errors[t] = std::current_exception(); }
+    });
+  }
+  try {
+    f(0);
+  } catch (...) { errors[0] = std::current_exception(); }
+  for (auto& th : threads) th.join();
+
+  for (auto& e : errors) {
+    if (e) std::rethrow_exception(e);
+  }
+}
+
+/**
+ * @brief Runs f(t, task, push) for every task on `num_threads` threads and waits for all of them.
+ *
+ * `t` is the index of the running thread and `push(task)` adds a new task, so tasks can spawn subtasks.
+ * Tasks are taken from a shared stack, so the most recently added one runs first.
+ * The first exception thrown by any of them is rethrown.
+ */
+template <typename Task, typename F>
+void run_tasks(int num_threads, std::vector<Task> tasks, F f) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  int running = 0;
+
+  auto push = [&mutex, &cv, &tasks](Task task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push_back(std::move(task));
+    }
+    cv.notify_one();
+  };
+
+  parallel_for(num_threads, [&](int t) {
+    for (;;) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return !tasks.empty() || running == 0; });
+        if (tasks.empty()) return;  // no task left and none running
+        task = std::move(tasks.back());
+        tasks.pop_back();
+        ++running;
+      }
+
+      // mark the task as finished even if it throws
+      struct Finish {
+        std::mutex& mutex;
+        std::condition_variable& cv;
+        int& running;
+        ~Finish() {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            --running;
+          }
+          cv.notify_all();
+        }
+      } finish = {mutex, cv, running};
+
+      f(t, task, push);
+    }
+  });
+}
+}  // namespace util
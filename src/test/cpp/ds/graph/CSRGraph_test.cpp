@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "ds/graph/CSRGraph.hpp"
+
+using namespace std;
+using namespace ds::graph;
+
+namespace {
+std::vector<std::pair<int, int>> edges = {                   //
+    {0, 1}, {1, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 3}, {4, 1},  //
+    {1, 5}, {3, 2}, {4, 2}, {5, 2}, {4, 6}, {6, 5}};
+
+template <typename Range>
+std::vector<int> to_vector(Range const& r) {
+  return std::vector<int>(r.begin(), r.end());
+}
+}  // namespace
+
+//
+// CSRGraphTest
+//
+TEST(CSRGraphTest, BasicOperations) {
+  auto G = CSRGraph(7, edges);
+
+  // properties
+  EXPECT_EQ(G.number_of_nodes(), 7);
+  EXPECT_EQ(G.number_of_edges(), 13);
+
+  // queries
+  EXPECT_TRUE(G.has_vertex(0));
+  EXPECT_TRUE(G.has_vertex(6));
+  EXPECT_FALSE(G.has_vertex(7));
+  EXPECT_FALSE(G.has_vertex(-1));
+
+  EXPECT_FALSE(G.has_edge(1, 1));
+  EXPECT_TRUE(G.has_edge(1, 3));
+  EXPECT_TRUE(G.has_edge(3, 1));
+  EXPECT_FALSE(G.has_edge(0, 2));
+  EXPECT_FALSE(G.has_edge(0, 7));
+
+  EXPECT_EQ(G.degree(0), 4);
+  EXPECT_EQ(G.degree(4), 4);
+  EXPECT_EQ(G.degree(6), 2);
+
+  // neighbors are sorted
+  EXPECT_EQ(to_vector(G.neighbors(0)), vector<int>({1, 3, 4, 5}));
+  EXPECT_EQ(to_vector(G.neighbors(2)), vector<int>({1, 3, 4, 5}));
+  EXPECT_EQ(to_vector(G.neighbors(6)), vector<int>({4, 5}));
+  EXPECT_EQ(G.neighbors(3).size(), 3);
+  EXPECT_EQ(G.neighbors(3)[2], 2);
+}
+
+TEST(CSRGraphTest, DuplicateEdges) {
+  auto G = CSRGraph(4, {{0, 1}, {1, 0}, {0, 1}, {2, 3}});
+  EXPECT_EQ(G.number_of_nodes(), 4);
+  EXPECT_EQ(G.number_of_edges(), 2);
+  EXPECT_EQ(to_vector(G.neighbors(0)), vector<int>({1}));
+  EXPECT_EQ(to_vector(G.neighbors(1)), vector<int>({0}));
+
+  // loops are ignored
+  auto H = CSRGraph(4, {{2, 2}, {2, 3}, {3, 3}});
+  EXPECT_EQ(H.number_of_edges(), 1);
+  EXPECT_EQ(to_vector(H.neighbors(3)), vector<int>({2}));
+
+  EXPECT_THROW(CSRGraph(4, {{0, 4}}), std::invalid_argument);
+  EXPECT_THROW(CSRGraph(4, {{-1, 0}}), std::invalid_argument);
+}
+
+TEST(CSRGraphTest, FromGraph) {
+  for (bool dense : {false, true}) {
+    auto G = Graph(7, edges, dense);
+    auto H = CSRGraph(G);
+
+    EXPECT_EQ(H.number_of_nodes(), 7);
+    EXPECT_EQ(H.number_of_edges(), 13);
+    for (int v = 0; v < 7; ++v) EXPECT_EQ(to_vector(H.neighbors(v)), to_vector(G.neighbors(v)));
+  }
+
+  auto E = CSRGraph(Graph());
+  EXPECT_EQ(E.number_of_nodes(), 0);
+  EXPECT_EQ(E.number_of_edges(), 0);
+}
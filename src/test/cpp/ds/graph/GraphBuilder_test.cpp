@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "ds/graph/CSRGraph.hpp"
+#include "util/Random.hpp"
+
+using namespace std;
+using namespace ds::graph;
+
+typedef std::vector<std::pair<int, int>> VII;
+
+TEST(GraphBuilderTest, BasicOperations) {
+  GraphBuilder builder(5);
+  builder.add_edges({{0, 1}, {1, 0}, {3, 3}, {4, 0}, {2, 1}, {0, 4}});
+  builder.add_edge(1, 2);
+
+  vector<GraphBuilder::offset_type> offsets;
+  vector<int> targets;
+  builder.build(offsets, targets);
+  EXPECT_EQ(offsets, vector<GraphBuilder::offset_type>({0, 2, 4, 5, 5, 6}));
+  EXPECT_EQ(targets, vector<int>({1, 4, 0, 2, 1, 0}));
+
+  EXPECT_THROW(builder.add_edge(0, 5), std::invalid_argument);
+
+  auto G = Graph(builder);
+  EXPECT_EQ(G.number_of_nodes(), 5);
+  EXPECT_EQ(G.number_of_edges(), 3);
+  EXPECT_TRUE(G.has_edge(4, 0));
+  EXPECT_FALSE(G.has_edge(3, 3));
+
+  auto H = CSRGraph(builder);
+  EXPECT_EQ(H.number_of_nodes(), 5);
+  EXPECT_EQ(H.number_of_edges(), 3);
+  EXPECT_TRUE(H.has_edge(1, 2));
+}
+
+TEST(GraphBuilderTest, RandomInput) {
+  util::Random rand(12345);
+  int n = 1000;
+  VII edges;
+  set<pair<int, int>> expected;
+
+  for (int i = 0; i < 300000; ++i) {
+    // skewed degrees
+    int u = rand.randint(0, rand.randint(0, n - 1));
+    int v = rand.randint(0, n - 1);
+    edges.push_back({u, v});
+    if (u != v) {
+      expected.insert({u, v});
+      expected.insert({v, u});
+    }
+  }
+
+  for (int num_threads : {1, 2, 3, 4}) {
+    vector<GraphBuilder::offset_type> offsets;
+    vector<int> targets;
+    GraphBuilder::build_adjacency(n, edges, num_threads, offsets, targets);
+
+    VII actual;
+    for (int u = 0; u < n; ++u) {
+      for (auto i = offsets[u]; i < offsets[u + 1]; ++i) actual.push_back({u, targets[i]});
+    }
+    EXPECT_EQ(actual, VII(expected.begin(), expected.end()));
+
+    // bucket the arcs by source in input order, then sort in place
+    vector<GraphBuilder::offset_type> pos(n + 1, 0);
+    for (auto &e : edges) {
+      if (e.first == e.second) continue;
+      ++pos[e.first + 1];
+      ++pos[e.second + 1];
+    }
+    for (int u = 0; u < n; ++u) pos[u + 1] += pos[u];
+    vector<GraphBuilder::offset_type> in_place_offsets(pos);
+    vector<int> in_place_targets(pos[n]);
+    for (auto &e : edges) {
+      if (e.first == e.second) continue;
+      in_place_targets[pos[e.first]++] = e.second;
+      in_place_targets[pos[e.second]++] = e.first;
+    }
+    GraphBuilder::sort_adjacency_in_place(n, num_threads, in_place_offsets, in_place_targets);
+    EXPECT_EQ(in_place_offsets, offsets);
+    EXPECT_EQ(in_place_targets, targets);
+  }
+}
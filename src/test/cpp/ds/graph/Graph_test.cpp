@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <type_traits>
+
 #include "ds/graph/Graph.hpp"
 
 using namespace std;
@@ -94,3 +96,71 @@ TEST(GraphTest, BasicOperationsDense) {
                                {0, 0, 0, 0, 1, 1, 0},
                            }));
 }
+
+TEST(GraphTest, Neighbors) {
+  for (bool dense : {false, true}) {
+    auto G = Graph(7, edges, dense);
+    std::vector<int> xs;
+    for (auto u : G.neighbors(4)) xs.push_back(u);
+    EXPECT_EQ(xs, vector<int>({0, 1, 2, 6}));
+
+    G.remove_vertex(1);
+    EXPECT_EQ(G.number_of_edges(), 8);
+    xs.clear();
+    for (auto u : G.neighbors(4)) xs.push_back(u);
+    EXPECT_EQ(xs, vector<int>({0, 2, 6}));
+    EXPECT_TRUE(G.neighbors(1).empty());
+  }
+}
+
+TEST(GraphTest, LargeDense) {
+  int n = 10000;
+  vector<pair<int, int>> es;
+  for (int i = 0; i < n; ++i) es.push_back({i, (i + 1) % n});
+  es.push_back({0, n / 2});
+
+  auto G = Graph(n, es, true);
+  EXPECT_EQ(G.number_of_edges(), n + 1);
+  EXPECT_TRUE(G.has_edge(n / 2, 0));
+  EXPECT_EQ(G.degree(0), 3);
+
+  std::vector<int> xs;
+  for (auto u : G.neighbors(0)) xs.push_back(u);
+  EXPECT_EQ(xs, vector<int>({1, n / 2, n - 1}));
+
+  G.remove_vertex(1);
+  EXPECT_EQ(G.number_of_edges(), n - 1);
+  EXPECT_FALSE(G.has_edge(0, 1));
+}
+
+TEST(GraphTest, PrefersDense) {
+  EXPECT_TRUE(Graph::prefers_dense(100, 0));
+  EXPECT_TRUE(Graph::prefers_dense(4095, 0));
+  EXPECT_FALSE(Graph::prefers_dense(10000, 10000));
+  EXPECT_TRUE(Graph::prefers_dense(10000, 400000));
+  EXPECT_FALSE(Graph::prefers_dense(1 << 18, 1ULL << 34));
+
+  static_assert(!std::is_convertible<GraphBuilder const&, Graph>::value, "Graph(GraphBuilder) must be explicit");
+  GraphBuilder builder(7);
+  builder.add_edges(edges);
+  auto G = Graph(builder);
+  EXPECT_EQ(G.number_of_edges(), 13);
+  EXPECT_EQ(create_adj(G), create_adj(Graph(7, edges)));
+  EXPECT_TRUE(G.is_dense());
+
+  // the edge-list constructor stays sparse unless told otherwise, so that it can grow
+  EXPECT_FALSE(Graph(7, edges).is_dense());
+  EXPECT_TRUE(Graph(7, edges, true).is_dense());
+
+  auto H = Graph(5);
+  EXPECT_FALSE(H.is_dense());
+  EXPECT_EQ(H.add_vertex(), 5);
+  EXPECT_EQ(H.add_vertex(), 6);
+  H.add_edge(0, 6);
+  EXPECT_EQ(H.number_of_nodes(), 7);
+  EXPECT_EQ(H.number_of_edges(), 1);
+
+  Graph E;
+  EXPECT_FALSE(E.is_dense());
+  EXPECT_EQ(E.add_vertex(), 0);
+}
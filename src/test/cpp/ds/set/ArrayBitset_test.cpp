@@ -96,6 +96,16 @@ TEST(ArrayBitsetTest, PopFront) {
   EXPECT_EQ(s.pop_front(), -1);
 }
 
+TEST(ArrayBitsetTest, Range) {
+  auto s = ArrayBitset14(10000);
+  EXPECT_TRUE(s.range().empty());
+
+  for (int x : {9999, 0, 63, 64, 130, 4095, 4096}) s.set(x);
+  std::vector<int> xs(s.range().begin(), s.range().end());
+  EXPECT_EQ(xs, std::vector<int>({0, 63, 64, 130, 4095, 4096, 9999}));
+  EXPECT_EQ(xs, s.to_vector());
+}
+
 // to be implemented
 // TEST(ArrayBitsetTest, PopBack) {
 //   auto s = ArrayBitset14(10000);
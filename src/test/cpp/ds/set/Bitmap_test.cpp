@@ -99,3 +99,17 @@ TEST(BitmapTest, EncodeTest) {
   EXPECT_EQ((~b0).to_string(), "ffffffffffffffffffffffffffffffff");
   EXPECT_EQ((~b1).to_string(), "fffffffffffffffffffffffffffffffe");
 }
+
+TEST(BitmapTest, BasicSet) {
+  Bitmap b(200, {3, 64, 130, 199});
+  EXPECT_EQ(b.front(), 3);
+  EXPECT_EQ(b.back(), 199);
+  EXPECT_EQ(b.pop_back(), 199);
+  EXPECT_EQ(b.back(), 130);
+
+  std::vector<int> xs;
+  for (auto x : b.range()) xs.push_back(x);
+  EXPECT_EQ(xs, std::vector<int>({3, 64, 130}));
+  EXPECT_TRUE(Bitmap(200).range().empty());
+  EXPECT_EQ(Bitmap(200).back(), -1);
+}
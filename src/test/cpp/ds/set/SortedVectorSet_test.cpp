@@ -105,3 +105,15 @@ TEST(SortedVectorSetTest, PopBack) {
   EXPECT_EQ(s.pop_back(), 5);
   EXPECT_EQ(s.pop_back(), -1);
 }
+
+TEST(SortedVectorSetTest, Range) {
+  auto s = SortedVectorSet();
+  EXPECT_TRUE(s.range().empty());
+
+  s.set(10);
+  s.set(20);
+  s.set(5);
+  std::vector<int> xs;
+  for (auto x : s.range()) xs.push_back(x);
+  EXPECT_EQ(xs, std::vector<int>({5, 10, 20}));
+}
@@ -14,7 +14,8 @@ typedef std::vector<std::string> VS;
 // IntNode r0(0), r3(3), r10(10), r13(13);
 // IntNode* nodes[20];
 
-IntRootedForest<int> initialize_inttree() {
+template <typename Layout = ArrayOfStructures>
+IntRootedForest<int, Layout> initialize_inttree() {
   // for (int i = 0; i < n; ++i) nodes[i] = new IntNode(i);
   //  0    3
   //       |
@@ -26,7 +27,7 @@ IntRootedForest<int> initialize_inttree() {
 
   // construction
   int n = 20;
-  auto tree = IntRootedForest<int>();
+  auto tree = IntRootedForest<int, Layout>();
   for (int i = 0; i < n; ++i) tree.create_node(i);
 
   VII relations = {{3, 1},   {3, 5},   {3, 4},   {5, 9},   {5, 2},   {4, 7},   {7, 6},   {7, 8},
@@ -343,3 +344,208 @@ TEST(IntRootedTreeTest, ReplaceChildren) {
   EXPECT_EQ(tree.to_string(3), "(3(1(0)))");
   tree.check_consistency();
 }
+
+TEST(IntRootedTreeTest, StructureOfArrays) {
+  auto expected = initialize_inttree();
+  auto tree = initialize_inttree<StructureOfArrays>();
+
+  auto check = [&]() {
+    tree.check_consistency();
+    for (int i = 0; i < static_cast<int>(tree.capacity()); ++i) {
+      ASSERT_EQ(tree.is_valid(i), expected.is_valid(i));
+      if (!tree.is_valid(i)) continue;
+      EXPECT_EQ(tree[i].data, expected[i].data);
+      EXPECT_EQ(tree.to_string(i), expected.to_string(i));
+      EXPECT_EQ(tree.get_leaves(i), expected.get_leaves(i));
+      EXPECT_EQ(tree[i].number_of_children(), expected[i].number_of_children());
+    }
+  };
+  check();
+
+  // modifications through the node proxy
+  tree[5].data = 50;
+  expected[5].data = 50;
+  auto &&node = tree[7];
+  node.data += 70;
+  expected[7].data += 70;
+  check();
+
+  tree.swap(4, 17);
+  tree.move_to_after(0, 2);
+  tree.replace_by_children(5);
+  tree.remove(5);
+  tree.move_to(tree.create_node(100), 13);
+  tree.add_children_from(13, 3);
+
+  expected.swap(4, 17);
+  expected.move_to_after(0, 2);
+  expected.replace_by_children(5);
+  expected.remove(5);
+  expected.move_to(expected.create_node(100), 13);
+  expected.add_children_from(13, 3);
+  check();
+
+  auto copied = tree;
+  EXPECT_EQ(copied.to_string(13), expected.to_string(13));
+  EXPECT_EQ(copied.create_node(200), 20);
+
+  tree.clear();
+  EXPECT_EQ(tree.size(), 0);
+  EXPECT_EQ(tree.create_node(1), 0);
+  EXPECT_TRUE(tree[0].is_root());
+  EXPECT_TRUE(tree[0].is_leaf());
+}
+
+TEST(IntRootedTreeTest, LazyTraversal) {
+  auto tree = initialize_inttree();
+  tree.move_to(tree.create_node(20), 2);
+
+  auto to_vector = [](auto const& range) {
+    VI ret;
+    for (auto x : range) ret.push_back(x);
+    return ret;
+  };
+
+  // reference traversals by an explicit stack over the raw links, independent of the lazy ranges
+  auto reference = [&tree](int root, VI &children, VI &nodes, VI &leaves, VI &ancestors) {
+    children.clear(), nodes.clear(), leaves.clear(), ancestors.clear();
+    for (int c = tree[root].first_child; c >= 0; c = tree[c].right) children.push_back(c);
+    VI stack = {root};
+    while (!stack.empty()) {
+      int x = stack.back();
+      stack.pop_back();
+      nodes.push_back(x);
+      if (tree[x].first_child < 0) leaves.push_back(x);
+      for (int c = tree[x].first_child; c >= 0; c = tree[c].right) stack.push_back(c);
+    }
+    for (int p = tree[root].parent; p >= 0; p = tree[p].parent) ancestors.push_back(p);
+  };
+
+  VI buf = {-1, -1, -1, -1, -1, -1, -1, -1};
+  VI children, nodes, leaves, ancestors;
+  for (int i = 0; i < 21; ++i) {
+    reference(i, children, nodes, leaves, ancestors);
+    EXPECT_EQ(to_vector(tree.children(i)), children);
+    EXPECT_EQ(to_vector(tree.dfs_reverse_preorder(i)), nodes);
+    EXPECT_EQ(to_vector(tree.leaves(i)), leaves);
+    EXPECT_EQ(to_vector(tree.ancestors(i)), ancestors);
+    EXPECT_EQ(tree.get_children(i), children);
+    EXPECT_EQ(tree.dfs_reverse_preorder_nodes(i), nodes);
+    EXPECT_EQ(tree.get_leaves(i), leaves);
+    EXPECT_EQ(tree.get_ancestors(i), ancestors);
+
+    tree.get_children(i, buf);
+    EXPECT_EQ(buf, tree.get_children(i));
+    tree.get_leaves(i, buf);
+    EXPECT_EQ(buf, tree.get_leaves(i));
+    tree.bfs_nodes(i, buf);
+    EXPECT_EQ(buf, tree.bfs_nodes(i));
+    tree.dfs_reverse_preorder_nodes(i, buf);
+    EXPECT_EQ(buf, tree.dfs_reverse_preorder_nodes(i));
+  }
+
+  EXPECT_EQ(tree.dfs_reverse_preorder_nodes(3), VI({3, 1, 5, 9, 2, 20, 4, 7, 6, 8}));
+  EXPECT_EQ(tree.get_leaves(3), VI({1, 9, 20, 6, 8}));
+  EXPECT_EQ(tree.dfs_reverse_preorder_nodes(5), VI({5, 9, 2, 20}));
+  EXPECT_EQ(tree.get_leaves(5), VI({9, 20}));
+  EXPECT_EQ(tree.dfs_reverse_preorder_nodes(4), VI({4, 7, 6, 8}));
+  EXPECT_EQ(tree.get_leaves(7), VI({6, 8}));
+  EXPECT_EQ(tree.dfs_reverse_preorder_nodes(13), VI({13, 11, 15, 19, 12, 14, 17, 16, 18}));
+  EXPECT_EQ(tree.get_leaves(13), VI({11, 19, 12, 16, 18}));
+  EXPECT_EQ(tree.get_leaves(0), VI({0}));
+  EXPECT_EQ(tree.bfs_nodes(3), VI({3, 4, 5, 1, 7, 2, 9, 8, 6, 20}));
+  EXPECT_EQ(to_vector(tree.ancestors(20)), VI({2, 5, 3}));
+
+  // node data can be modified during iteration
+  for (auto x : tree.dfs_reverse_preorder(4)) tree[x].data = -x;
+  EXPECT_EQ(tree[7].data, -7);
+}
+
+TEST(IntRootedTreeTest, FreeList) {
+  auto tree = initialize_inttree();
+
+  // removed slots are reused in the order of removal
+  tree.remove(9);
+  tree.remove(2);
+  tree.remove(0);
+  EXPECT_EQ(tree.create_node(90), 9);
+  EXPECT_EQ(tree.create_node(91), 2);
+
+  auto copied = tree;
+  EXPECT_EQ(copied.create_node(92), 0);
+  EXPECT_EQ(copied.create_node(93), 20);
+  EXPECT_EQ(tree.create_node(92), 0);
+
+  tree.clear();
+  EXPECT_EQ(tree.create_node(94), 0);
+  EXPECT_EQ(tree.create_node(95), 1);
+}
+
+TEST(IntRootedTreeTest, Compact) {
+  auto tree = initialize_inttree();
+  tree.remove(2);
+  tree.remove(9);
+  tree.remove(0);
+  tree.move_to(tree.create_node(90), 5);
+  EXPECT_EQ(tree.to_string(3), "(3(4(7(8)(6)))(5(90))(1))");
+
+  auto mapping = tree.compact();
+  EXPECT_EQ(mapping, VI({-1, 7, 6, 0, 1, 5, 4, 2, 3, -1, 8, 17, 15, 9, 10, 14, 13, 11, 12, 16}));
+  EXPECT_EQ(tree.size(), 18);
+  EXPECT_EQ(tree.capacity(), 18);
+  EXPECT_EQ(tree.get_roots(), VI({0, 8, 9}));
+  EXPECT_EQ(tree.to_string(0), "(3(4(7(8)(6)))(5(90))(1))");
+  EXPECT_EQ(tree.to_string(9), "(13(14(17(18)(16)))(15(12)(19))(11))");
+  EXPECT_EQ(tree.create_node(), 18);
+  tree.check_consistency();
+
+  // keep the leading nodes in place
+  auto tree2 = initialize_inttree<StructureOfArrays>();
+  tree2.remove(9);
+  mapping = tree2.compact(4);
+  EXPECT_EQ(mapping, VI({0, 1, 2, 3, 4, 8, 7, 5, 6, -1, 9, 18, 16, 10, 11, 15, 14, 12, 13, 17}));
+  EXPECT_EQ(tree2.capacity(), 19);
+  EXPECT_EQ(tree2.to_string(3), "(3(4(7(8)(6)))(5(2))(1))");
+  tree2.check_consistency();
+
+  tree2.remove(0);
+  EXPECT_THROW(tree2.compact(4), std::invalid_argument);
+}
+
+TEST(IntRootedTreeTest, IndexType) {
+  typedef IntRootedForest<int, ArrayOfStructures, uint16_t> Tree16;
+  typedef IntRootedForest<int, StructureOfArrays, uint32_t> Tree32;
+  EXPECT_EQ(Tree16::NOT_AVAILABLE, 0xffff);
+  EXPECT_EQ(Tree32::NOT_AVAILABLE, 0xffffffffu);
+
+  Tree16 tree;
+  for (int i = 0; i < 10; ++i) tree.create_node(i);
+  VII relations = {{3, 1}, {3, 5}, {3, 4}, {5, 9}, {5, 2}, {4, 7}, {7, 6}, {7, 8}};
+  for (auto &p : relations) tree.move_to(p.second, p.first);
+  EXPECT_EQ(tree.to_string(3), "(3(4(7(8)(6)))(5(2)(9))(1))");
+  EXPECT_EQ(tree.get_roots(), vector<uint16_t>({0, 3}));
+  EXPECT_TRUE(tree[3].is_root());
+  EXPECT_TRUE(tree[8].is_first_child());
+  EXPECT_TRUE(tree[6].is_last_child());
+  EXPECT_EQ(tree[7].number_of_children(), 2);
+
+  tree.remove(2);
+  tree.replace_by_children(4);
+  EXPECT_EQ(tree.to_string(3), "(3(7(8)(6))(5(9))(1))");
+  EXPECT_EQ(tree.compact(), vector<uint16_t>({0, 7, 0xffff, 1, 8, 5, 4, 2, 3, 6}));
+  EXPECT_EQ(tree.to_string(1), "(3(7(8)(6))(5(9))(1))");
+  tree.check_consistency();
+
+  Tree32 tree32;
+  auto r = tree32.create_node(0);
+  tree32.move_to(tree32.create_node(1), r);
+  EXPECT_EQ(tree32.to_string(0), "(0(1))");
+  EXPECT_EQ(tree32.get_ancestors(1), vector<uint32_t>({0}));
+
+  // running out of indices
+  auto small = IntRootedForest<int, ArrayOfStructures, uint16_t>();
+  for (int i = 0; i < 0xffff; ++i) small.create_node(i);
+  EXPECT_THROW(small.create_node(0), std::length_error);
+  small.remove(100);
+  EXPECT_EQ(small.create_node(0), 100);
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <functional>
+#include <random>
+
 #include "modular/MDTree.hpp"
+#include "util/Random.hpp"
 
 using namespace std;
 using namespace ds::graph;
@@ -27,6 +31,8 @@ TEST(MDTreeTest, MDTree) {
 
   MDTree t(g, true);
   EXPECT_EQ(t.to_string(), "(P(U(0)(J(4)(5)))(1)(J(2)(U(3)(7)))(6))");
+  EXPECT_EQ(t.to_string({10, 11, 12, 13, 14, 15, 16, -17}), "(P(U(10)(J(14)(15)))(11)(J(12)(U(13)(-17)))(16))");
+  EXPECT_EQ(t.to_string(vector<int64_t>()), t.to_string());
   EXPECT_EQ(t.get_root(), 12);
   EXPECT_EQ(t.get_vertex(0), 0);
   EXPECT_EQ(t.get_vertex(1), 4);
@@ -60,6 +66,20 @@ TEST(MDTreeTest, MDTree2) {
   EXPECT_EQ(t.modular_width(), 4);
 }
 
+TEST(MDTreeTest, MDTreeCSR) {
+  vector<pair<int, int>> edges = {
+      {0, 2}, {0, 3}, {0, 6}, {0, 7}, {1, 6}, {2, 3}, {2, 4}, {2, 5},
+      {2, 7}, {3, 4}, {3, 5}, {4, 5}, {4, 6}, {4, 7}, {5, 6}, {5, 7},
+  };
+  CSRGraph g(8, edges);
+
+  MDTree t(g, true);
+  EXPECT_EQ(t.to_string(), "(P(U(0)(J(4)(5)))(1)(J(2)(U(3)(7)))(6))");
+  EXPECT_EQ(t.modular_width(), 4);
+
+  EXPECT_EQ(MDTree(CSRGraph()).get_root(), -1);
+}
+
 TEST(MDTreeTest, MDTree8) {
   vector<pair<int, int>> edges = {{0, 2},  {0, 5},  {1, 2},  {1, 3}, {2, 4},  {3, 5},  {3, 12},
                                   {5, 13}, {6, 10}, {6, 13}, {7, 8}, {7, 11}, {9, 13}, {11, 13}};
@@ -190,3 +210,229 @@ TEST(MDTreeTest, MDTree16) {
             "(J(16)(17)(18))(J(19)(20)(21))(J(22)(23)(24)))");
   EXPECT_EQ(t2.modular_width(), 14);
 }
+
+TEST(MDTreeTest, Workspace) {
+  util::Random rand(12345);
+  compute::SolverWorkspace ws;
+
+  // graphs of varying sizes share one workspace
+  for (int n : {30, 5, 0, 1, 50, 8, 30}) {
+    vector<pair<int, int>> edges;
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        if (rand.random() < 0.3) edges.push_back({i, j});
+      }
+    }
+    CSRGraph g(n, edges);
+    auto expected = MDTree(g, true).to_string();
+    EXPECT_EQ(MDTree(g, ws, true).to_string(), expected);
+    EXPECT_EQ(modular_decomposition(g, ws, true).to_string(), expected);
+  }
+}
+
+TEST(MDTreeTest, IndexTypes) {
+  static_assert(sizeof(compute::BasicMDComputeNode<uint16_t>) < sizeof(compute::MDComputeNode),
+                "16-bit nodes should be smaller");
+  util::Random rand(12345);
+  compute::BasicSolverWorkspace<uint16_t> ws16;
+  compute::BasicSolverWorkspace<uint32_t> ws32;
+  compute::BasicSolverWorkspace<int64_t> ws64;
+
+  for (int n : {30, 5, 0, 1, 200, 8}) {
+    vector<pair<int, int>> edges;
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        if (rand.random() < 0.3) edges.push_back({i, j});
+      }
+    }
+    CSRGraph g(n, edges);
+    auto expected = MDTree(g, true);
+    EXPECT_EQ(MDTree(g, ws16, true).to_string(), expected.to_string());
+    EXPECT_EQ(MDTree(g, ws32, true).to_string(), expected.to_string());
+    EXPECT_EQ(modular_decomposition(g, ws64, true).to_string(), expected.to_string());
+    EXPECT_EQ(MDTree(g, ws16).modular_width(), expected.modular_width());
+  }
+
+  // 16-bit indices run out instead of wrapping around
+  EXPECT_THROW(MDTree(CSRGraph(70000, {}), ws16), std::length_error);
+  EXPECT_EQ(MDTree(CSRGraph(3, {{0, 1}}), ws16, true).to_string(), "(U(J(0)(1))(2))");
+}
+
+TEST(MDTreeTest, Move) {
+  static_assert(std::is_nothrow_move_constructible<MDTree>::value, "MDTree should be movable without copying");
+  static_assert(std::is_nothrow_move_assignable<compute::CompTree>::value,
+                "CompTree should be movable without copying");
+
+  Graph g(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {0, 2}});
+  MDTree t(g, true);
+  auto expected = t.to_string();
+
+  MDTree moved(std::move(t));
+  EXPECT_EQ(moved.to_string(), expected);
+  EXPECT_EQ(t.get_root(), -1);
+  EXPECT_EQ(t.modular_width(), 0);
+
+  t = std::move(moved);
+  EXPECT_EQ(t.to_string(), expected);
+  EXPECT_EQ(moved.get_root(), -1);
+
+  auto result = compute::MDSolver::compute(g);
+  auto comp_tree = std::move(result.first);
+  EXPECT_EQ(result.first.size(), 0);
+  EXPECT_EQ(MDTree(comp_tree, result.second).modular_width(), t.modular_width());
+}
+
+/**
+ * @brief Checks that the concurrent decomposition matches the sequential one.
+ */
+void expect_same_decomposition(CSRGraph const& g, vector<int> const& thread_counts = {1, 3, 0}) {
+  auto expected = MDTree(g, true);
+  for (int num_threads : thread_counts) {
+    auto t = modular_decomposition(g, true, num_threads);
+    EXPECT_EQ(t.to_string(), expected.to_string());
+    EXPECT_EQ(t.modular_width(), expected.modular_width());
+    for (int i = 0; i < static_cast<int>(g.number_of_nodes()); ++i) EXPECT_EQ(t.get_vertex(i), expected.get_vertex(i));
+    EXPECT_EQ(modular_decomposition_time(g, true, nullptr, num_threads).first.to_string(), expected.to_string());
+  }
+}
+
+/**
+ * @brief Returns a random graph whose components are the residues modulo k, with isolated vertices, or its complement.
+ */
+CSRGraph interleaved_components(int n, int k, bool complemented, util::Random& rand) {
+  vector<pair<int, int>> edges;
+  for (int i = 0; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      bool edge = i % k == j % k && i % 7 != 3 && j % 7 != 3 && rand.random() < 0.2;
+      if (edge != complemented) edges.push_back({i, j});
+    }
+  }
+  return CSRGraph(n, edges);
+}
+
+TEST(MDTreeTest, ParallelComponents) {
+  util::Random rand(12345);
+  for (int k : {1, 2, 5, 20}) expect_same_decomposition(interleaved_components(200, k, false, rand));
+
+  // edgeless graph
+  auto t = modular_decomposition(CSRGraph(3, {}), true, 2);
+  EXPECT_EQ(t.to_string(), "(U(0)(1)(2))");
+  EXPECT_EQ(t.get_tree()[t.get_root()].data.size(), 3);
+
+  // the profiler is single-threaded
+  util::Profiler prof;
+  EXPECT_THROW(modular_decomposition_time(CSRGraph(3, {}), true, &prof, 2), std::invalid_argument);
+  EXPECT_EQ(modular_decomposition_time(CSRGraph(3, {}), true, &prof, 1).first.to_string(), "(U(0)(1)(2))");
+}
+
+TEST(MDTreeTest, ParallelCoComponents) {
+  util::Random rand(12345);
+  for (int k : {1, 2, 5, 20}) expect_same_decomposition(interleaved_components(200, k, true, rand));
+
+  // complete graph
+  auto t = modular_decomposition(CSRGraph(3, {{0, 1}, {0, 2}, {1, 2}}), true, 2);
+  EXPECT_EQ(t.to_string(), "(J(0)(1)(2))");
+}
+
+TEST(MDTreeTest, ParallelNestedParts) {
+  util::Random rand(12345);
+
+  // random cographs with small random graphs at the bottom, so that parts are split at several levels
+  for (int trial = 0; trial < 5; ++trial) {
+    int n = 300;
+    vector<pair<int, int>> edges;
+    vector<int> labels(n);
+    for (int i = 0; i < n; ++i) labels[i] = i;
+    std::function<void(int, int, int)> build = [&](int b, int e, int depth) {
+      if (e - b <= 6) {
+        for (int i = b; i < e; ++i) {
+          for (int j = i + 1; j < e; ++j) {
+            if (rand.random() < 0.5) edges.push_back({labels[i], labels[j]});
+          }
+        }
+        return;
+      }
+      int m = rand.randint(b + 1, e - 1);
+      if (depth % 2 == 0) {
+        for (int i = b; i < m; ++i) {
+          for (int j = m; j < e; ++j) edges.push_back({labels[i], labels[j]});
+        }
+      }
+      build(b, m, depth + 1);
+      build(m, e, depth + 1);
+    };
+    std::shuffle(labels.begin(), labels.end(), std::mt19937(trial));
+    build(0, n, trial);
+    expect_same_decomposition(CSRGraph(n, edges), {2, 4});
+  }
+
+  // series parts under a parallel split, next to single vertices
+  CSRGraph g(7, {{1, 2}, {1, 3}, {2, 3}, {5, 6}});
+  EXPECT_EQ(modular_decomposition(g, true, 2).to_string(), "(U(0)(J(1)(2)(3))(4)(J(5)(6)))");
+  expect_same_decomposition(g);
+
+  // parallel parts under a series split
+  CSRGraph h(4, {{0, 1}, {0, 2}, {0, 3}, {1, 3}, {2, 3}});
+  EXPECT_EQ(modular_decomposition(h, true, 2).to_string(), "(J(0)(U(1)(2))(3))");
+  expect_same_decomposition(h);
+}
+
+TEST(MDTreeTest, ParallelRejectedSplits) {
+  // threshold graphs: every split peels off one vertex, so only the top-level split passes the 7/8 rule
+  for (int n : {10, 100}) {
+    vector<pair<int, int>> edges;
+    for (int i = 1; i < n; i += 2) {
+      for (int j = 0; j < i; ++j) edges.push_back({j, i});  // odd vertices dominate the smaller ones
+    }
+    CSRGraph g(n, edges);
+    if (n == 10) {
+      EXPECT_EQ(modular_decomposition(g, true, 2).to_string(),
+                "(J(U(J(U(J(U(J(U(J(0)(1))(2))(3))(4))(5))(6))(7))(8))(9))");
+    }
+    expect_same_decomposition(g);
+  }
+}
+
+TEST(MDTreeTest, DecomposeBatch) {
+  util::Random rand(12345);
+
+  vector<CSRGraph> graphs;
+  for (int i = 0; i < 100; ++i) {
+    int n = i % 13;
+    vector<pair<int, int>> edges;
+    for (int u = 0; u < n; ++u) {
+      for (int v = u + 1; v < n; ++v) {
+        if (rand.random() < 0.4) edges.push_back({u, v});
+      }
+    }
+    graphs.push_back(CSRGraph(n, edges));
+  }
+
+  for (int num_threads : {1, 3, 0}) {
+    auto ts = decompose_batch(graphs, true, num_threads);
+    ASSERT_EQ(ts.size(), graphs.size());
+    for (std::size_t i = 0; i < graphs.size(); ++i) EXPECT_EQ(ts[i].to_string(), MDTree(graphs[i], true).to_string());
+
+    // results come in input order
+    vector<std::size_t> order;
+    decompose_batch(
+        graphs.size(), [&graphs](std::size_t i) { return graphs[i]; },
+        [&order](std::size_t i, MDTree&&) { order.push_back(i); }, false, num_threads);
+    EXPECT_EQ(order.size(), graphs.size());
+    for (std::size_t i = 0; i < order.size(); ++i) EXPECT_EQ(order[i], i);
+  }
+  EXPECT_TRUE(decompose_batch(vector<CSRGraph>(), true, 2).empty());
+
+  // errors from loading or emitting are rethrown
+  auto load_fail = [&graphs](std::size_t i) {
+    if (i == 50) throw std::invalid_argument("load");
+    return graphs[i];
+  };
+  EXPECT_THROW(decompose_batch(graphs.size(), load_fail, [](std::size_t, MDTree&&) {}, false, 3),
+               std::invalid_argument);
+  auto emit_fail = [](std::size_t i, MDTree&&) {
+    if (i == 50) throw std::invalid_argument("emit");
+  };
+  EXPECT_THROW(decompose_batch(graphs.size(), [&graphs](std::size_t i) { return graphs[i]; }, emit_fail, false, 3),
+               std::invalid_argument);
+}
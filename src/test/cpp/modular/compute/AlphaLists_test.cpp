@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "modular/compute/AlphaLists.hpp"
+
+using namespace std;
+using namespace modular::compute;
+
+namespace {
+vector<int> to_vector(AlphaLists::Range const& r) { return vector<int>(r.begin(), r.end()); }
+}  // namespace
+
+TEST(AlphaListsTest, BasicOperations) {
+  ds::graph::CSRGraph G(4, vector<pair<int, int>>({{0, 1}, {0, 2}, {1, 2}}));
+  AlphaLists alpha(G);
+
+  EXPECT_TRUE(alpha[0].empty());
+  alpha.push_back(0, 1);
+  alpha.push_back(0, 2);
+  alpha.push_back(1, 0);
+  EXPECT_EQ(to_vector(alpha[0]), vector<int>({1, 2}));
+  EXPECT_EQ(to_vector(alpha[1]), vector<int>({0}));
+  EXPECT_TRUE(alpha[2].empty());
+
+  // exceed the initial capacity, including a vertex without neighbors
+  for (int i = 0; i < 10; ++i) {
+    alpha.push_back(0, i);
+    alpha.push_back(3, i);
+  }
+  EXPECT_EQ(alpha.size(0), 12);
+  EXPECT_EQ(alpha[0][1], 2);
+  EXPECT_EQ(alpha[0][11], 9);
+  EXPECT_EQ(alpha.size(3), 10);
+  EXPECT_EQ(to_vector(alpha[1]), vector<int>({0}));
+
+  alpha.data(0)[0] = 5;
+  alpha.pop_back(0);
+  EXPECT_EQ(alpha.size(0), 11);
+  EXPECT_EQ(alpha[0][0], 5);
+
+  alpha.clear(0);
+  EXPECT_TRUE(alpha[0].empty());
+  alpha.push_back(0, 3);
+  EXPECT_EQ(to_vector(alpha[0]), vector<int>({3}));
+  EXPECT_EQ(alpha.size(3), 10);
+}
+
+TEST(AlphaListsTest, NarrowVertexType) {
+  ds::graph::CSRGraph G(3, vector<pair<int, int>>({{0, 1}, {0, 2}}));
+  BasicAlphaLists<uint16_t> alpha(G);
+
+  for (int i = 0; i < 5; ++i) alpha.push_back(1, 60000 + i);
+  EXPECT_EQ(alpha.size(1), 5);
+  EXPECT_EQ(alpha[1][4], 60004);
+  EXPECT_TRUE(alpha[0].empty());
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "readwrite/Decompressor.hpp"
+#include "readwrite/dimacs.hpp"
+#include "readwrite/edge_list.hpp"
+#include "readwrite/load_graph.hpp"
+#include "util/Random.hpp"
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace std;
+using namespace readwrite;
+
+namespace {
+#if HAVE_ZLIB
+string gzip(string const& s) {
+  z_stream zs = {};
+  deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  string ret(deflateBound(&zs, s.size()) + 32, '\0');
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(s.data()));
+  zs.avail_in = s.size();
+  zs.next_out = reinterpret_cast<Bytef*>(&ret[0]);
+  zs.avail_out = ret.size();
+  deflate(&zs, Z_FINISH);
+  ret.resize(zs.total_out);
+  deflateEnd(&zs);
+  return ret;
+}
+#endif
+
+string random_edge_list(int num_edges) {
+  util::Random rand(12345);
+  string s;
+  for (int i = 0; i < num_edges; ++i) {
+    s += to_string(rand.randint(0, 9999)) + " " + to_string(rand.randint(0, 9999)) + "\n";
+    if (i % 100 == 0) s += "# comment\n";
+  }
+  return s;
+}
+
+string decompress(string const& s, size_t block_size) {
+  string ret;
+  Decompressor d(s.data(), s.data() + s.size(), detect_compression(s.data(), s.data() + s.size()), block_size);
+  d.for_each_lines([&](char const* b, char const* e) {
+    EXPECT_TRUE(b != e);
+    ret.append(b, e);
+  });
+  return ret;
+}
+}  // namespace
+
+TEST(DecompressorTest, DetectCompression) {
+  string plain = "0 1\n", gz = "\x1f\x8b\x08", zst = "\x28\xb5\x2f\xfd";
+  EXPECT_EQ(detect_compression(plain.data(), plain.data() + plain.size()), Compression::NONE);
+  EXPECT_EQ(detect_compression(gz.data(), gz.data() + gz.size()), Compression::GZIP);
+  EXPECT_EQ(detect_compression(zst.data(), zst.data() + zst.size()), Compression::ZSTD);
+  EXPECT_EQ(detect_compression(zst.data(), zst.data() + 2), Compression::NONE);
+}
+
+#if HAVE_ZLIB
+TEST(DecompressorTest, Gzip) {
+  auto s = random_edge_list(20000);
+  auto gz = gzip(s);
+
+  // lines split across blocks
+  for (size_t block_size : {1, 7, 4096, 1 << 22}) EXPECT_EQ(decompress(gz, block_size), s);
+
+  // concatenated members
+  EXPECT_EQ(decompress(gzip("0 1\n2 ") + gzip("3\n"), 5), "0 1\n2 3\n");
+
+  // empty and unterminated
+  EXPECT_EQ(decompress(gzip(""), 16), "");
+  EXPECT_EQ(decompress(gzip("0 1"), 16), "0 1");
+
+  // truncated and corrupt
+  auto truncated = gz.substr(0, gz.size() / 2);
+  EXPECT_THROW(decompress_all(truncated.data(), truncated.data() + truncated.size(), Compression::GZIP),
+               std::invalid_argument);
+  auto corrupt = gz;
+  corrupt[20] ^= 0x55;
+  EXPECT_THROW(decompress_all(corrupt.data(), corrupt.data() + corrupt.size(), Compression::GZIP),
+               std::invalid_argument);
+
+  // consumer quits early
+  EXPECT_EQ(decompress_head(gz.data(), gz.data() + gz.size(), Compression::GZIP, 10),
+            vector<char>(s.begin(), s.begin() + 10));
+}
+
+TEST(DecompressorTest, GzipReaders) {
+  auto s = random_edge_list(20000);
+  auto gz = gzip(s);
+
+  auto p = parse_edge_list(s.data(), s.data() + s.size());
+  auto q = parse_edge_list(gz.data(), gz.data() + gz.size());
+  EXPECT_EQ(q.first, p.first);
+  EXPECT_EQ(q.second, p.second);
+
+  auto g = parse_edge_list_csr(s.data(), s.data() + s.size());
+  auto h = parse_edge_list_csr(gz.data(), gz.data() + gz.size(), 4);
+  ASSERT_EQ(h.number_of_edges(), g.number_of_edges());
+  EXPECT_TRUE(std::equal(h.targets(), h.targets() + 2 * h.number_of_edges(), g.targets()));
+  auto bad = gzip("0 1\n1 x\n");
+  EXPECT_THROW(parse_edge_list_csr(bad.data(), bad.data() + bad.size()), std::invalid_argument);
+
+  string pace = gzip("c comment\np tw 3 2\n1 2\n2 3\n");
+  EXPECT_EQ(parse_pace(pace.data(), pace.data() + pace.size()).number_of_edges(), 2);
+
+  string path = testing::TempDir() + "decompressor_test.gr.gz";
+  { ofstream f(path, ios::binary); f << pace; }
+  EXPECT_EQ(load_graph(path.c_str()).number_of_edges(), 2);
+  std::remove(path.c_str());
+}
+#endif
+
+#if HAVE_ZSTD
+TEST(DecompressorTest, Zstd) {
+  auto s = random_edge_list(20000);
+  string zst(ZSTD_compressBound(s.size()), '\0');
+  zst.resize(ZSTD_compress(&zst[0], zst.size(), s.data(), s.size(), 3));
+
+  for (size_t block_size : {1, 7, 4096, 1 << 22}) EXPECT_EQ(decompress(zst, block_size), s);
+  EXPECT_EQ(decompress(zst + zst, 4096), s + s);
+
+  auto truncated = zst.substr(0, zst.size() / 2);
+  EXPECT_THROW(decompress_all(truncated.data(), truncated.data() + truncated.size(), Compression::ZSTD),
+               std::invalid_argument);
+}
+#endif
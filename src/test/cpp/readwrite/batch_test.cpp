@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "readwrite/batch.hpp"
+#include "readwrite/binary.hpp"
+
+using namespace std;
+using namespace readwrite;
+
+namespace {
+vector<vector<int>> adjacency(ds::graph::CSRGraph const& g) {
+  vector<vector<int>> ret;
+  for (std::size_t v = 0; v < g.number_of_nodes(); ++v) {
+    auto nbrs = g.neighbors(v);
+    ret.push_back(vector<int>(nbrs.begin(), nbrs.end()));
+  }
+  return ret;
+}
+
+vector<string> blocks(string const& s) {
+  vector<string> ret;
+  for (auto& b : split_blocks(s.data(), s.data() + s.size())) ret.push_back(string(b.first, b.second));
+  return ret;
+}
+}  // namespace
+
+TEST(BatchTest, SplitBlocks) {
+  EXPECT_EQ(blocks("0 1\n1 2\n\n# c\n3 4\n \t\r\n\n5 6"), vector<string>({"0 1\n1 2\n", "# c\n3 4\n", "5 6"}));
+  EXPECT_EQ(blocks("\n\r\n0 1\r\n\r\n"), vector<string>({"0 1\r\n"}));
+  EXPECT_TRUE(blocks("").empty());
+  EXPECT_TRUE(blocks("\n \n").empty());
+}
+
+TEST(BatchTest, Stream) {
+  istringstream is("0 1\n1 2\n\n10 30\n\n\n5 6\n");
+  GraphBatch batch(is);
+  ASSERT_EQ(batch.size(), 3);
+  EXPECT_EQ(adjacency(batch.load(0)), vector<vector<int>>({{1}, {0, 2}, {1}}));
+  EXPECT_EQ(batch.load(1).number_of_nodes(), 31);
+
+  vector<int64_t> labels;
+  EXPECT_EQ(adjacency(batch.load(1, &labels)), vector<vector<int>>({{1}, {0}}));
+  EXPECT_EQ(labels, vector<int64_t>({10, 30}));
+  EXPECT_EQ(batch.load(2).number_of_edges(), 1);
+  EXPECT_THROW(batch.load(3), std::invalid_argument);
+}
+
+TEST(BatchTest, BinaryContainer) {
+  string dir = testing::TempDir() + "batch_test";
+  ::mkdir(dir.c_str(), 0755);
+  string a = dir + "/a.bin", b = dir + "/b.txt", c = dir + "/c.bin", all = testing::TempDir() + "batch_test.bin";
+
+  auto g = ds::graph::CSRGraph(4, {{0, 1}, {1, 2}, {2, 3}});
+  auto h = ds::graph::CSRGraph(3, {{0, 2}});
+  vector<int64_t> h_labels = {7, 8, 9};
+  save_binary_graph(a.c_str(), g);
+  save_binary_graph(c.c_str(), h, &h_labels);
+  ofstream(b) << "0 1\n";
+
+  // concatenation of binary graphs
+  {
+    ofstream out(all, ios::binary);
+    out << ifstream(a, ios::binary).rdbuf() << ifstream(c, ios::binary).rdbuf() << ifstream(a, ios::binary).rdbuf();
+  }
+  vector<vector<int64_t>> labels;
+  auto gs = load_binary_graphs(all.c_str(), &labels);
+  ASSERT_EQ(gs.size(), 3);
+  EXPECT_EQ(adjacency(gs[0]), adjacency(g));
+  EXPECT_EQ(adjacency(gs[1]), adjacency(h));
+  EXPECT_EQ(adjacency(gs[2]), adjacency(g));
+  EXPECT_EQ(labels, vector<vector<int64_t>>({{}, h_labels, {}}));
+  EXPECT_THROW(load_binary_graph(all.c_str()), std::invalid_argument);
+
+  GraphBatch batch(all.c_str());
+  ASSERT_EQ(batch.size(), 3);
+  vector<int64_t> ls;
+  EXPECT_EQ(adjacency(batch.load(1, &ls)), adjacency(h));
+  EXPECT_EQ(ls, h_labels);
+
+  // the same concatenation piped in; loaded graphs keep the buffer alive
+  ds::graph::CSRGraph piped;
+  {
+    ifstream in(all, ios::binary);
+    GraphBatch stream_batch(in);
+    ASSERT_EQ(stream_batch.size(), 3);
+    EXPECT_EQ(adjacency(stream_batch.load(0)), adjacency(g));
+    EXPECT_EQ(adjacency(stream_batch.load(1, &ls)), adjacency(h));
+    EXPECT_EQ(ls, h_labels);
+    piped = stream_batch.load(2);
+  }
+  EXPECT_EQ(adjacency(piped), adjacency(g));
+
+  // truncated concatenation
+  {
+    ofstream out(all, ios::binary | ios::app);
+    out << "MDCSRBIN";
+  }
+  EXPECT_THROW(load_binary_graphs(all.c_str()), std::invalid_argument);
+
+  // directory in the order of names
+  GraphBatch files(dir.c_str());
+  ASSERT_EQ(files.size(), 3);
+  EXPECT_EQ(adjacency(files.load(0)), adjacency(g));
+  EXPECT_EQ(adjacency(files.load(1)), vector<vector<int>>({{1}, {0}}));
+  EXPECT_EQ(adjacency(files.load(2)), adjacency(h));
+
+  for (auto& p : {a, b, c, all}) std::remove(p.c_str());
+  ::rmdir(dir.c_str());
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "readwrite/binary.hpp"
+#include "readwrite/load_graph.hpp"
+
+using namespace std;
+using namespace readwrite;
+
+namespace {
+vector<vector<int>> adjacency(ds::graph::CSRGraph const& g) {
+  vector<vector<int>> ret;
+  for (std::size_t v = 0; v < g.number_of_nodes(); ++v) {
+    auto nbrs = g.neighbors(v);
+    ret.push_back(vector<int>(nbrs.begin(), nbrs.end()));
+  }
+  return ret;
+}
+}  // namespace
+
+TEST(BinaryTest, SaveAndLoad) {
+  string path = testing::TempDir() + "binary_test.bin";
+  auto g = ds::graph::CSRGraph(6, {{0, 1}, {1, 2}, {2, 0}, {3, 4}, {0, 4}});
+
+  // without labels
+  save_binary_graph(path.c_str(), g);
+  vector<int64_t> labels = {1, 2, 3};
+  auto h = load_binary_graph(path.c_str(), &labels);
+  EXPECT_EQ(h.number_of_nodes(), 6);
+  EXPECT_EQ(h.number_of_edges(), 5);
+  EXPECT_EQ(adjacency(h), adjacency(g));
+  EXPECT_TRUE(labels.empty());
+
+  // with labels
+  vector<int64_t> expected = {10, -20, 1LL << 40, 7, 8, 9};
+  save_binary_graph(path.c_str(), g, &expected);
+  h = load_binary_graph(path.c_str(), &labels);
+  EXPECT_EQ(adjacency(h), adjacency(g));
+  EXPECT_EQ(labels, expected);
+
+  auto copied = h;
+  EXPECT_EQ(adjacency(load_graph(path.c_str())), adjacency(g));
+  EXPECT_EQ(adjacency(copied), adjacency(g));
+
+  // empty graph
+  save_binary_graph(path.c_str(), ds::graph::CSRGraph());
+  EXPECT_EQ(load_binary_graph(path.c_str()).number_of_nodes(), 0);
+
+  std::remove(path.c_str());
+}
+
+TEST(BinaryTest, InvalidInput) {
+  string path = testing::TempDir() + "binary_test.bin";
+  auto g = ds::graph::CSRGraph(3, {{0, 1}, {1, 2}});
+  save_binary_graph(path.c_str(), g);
+
+  auto corrupt = [&](std::size_t pos, char c) {
+    fstream f(path, ios::in | ios::out | ios::binary);
+    f.seekp(pos);
+    f.put(c);
+  };
+
+  // asymmetric adjacency: 2 -> 0 without 0 -> 2
+  corrupt(32 + 8 * 4 + 4 * 3, 0);
+  EXPECT_THROW(load_binary_graph(path.c_str()), std::invalid_argument);
+  EXPECT_NO_THROW(load_binary_graph(path.c_str(), nullptr, false));
+  save_binary_graph(path.c_str(), g);
+
+  // unsorted targets
+  corrupt(32 + 8 * 4 + 4 * 2, 9);
+  EXPECT_THROW(load_binary_graph(path.c_str()), std::invalid_argument);
+  EXPECT_NO_THROW(load_binary_graph(path.c_str(), nullptr, false));
+
+  // unsupported version
+  corrupt(8, 2);
+  EXPECT_THROW(load_binary_graph(path.c_str()), std::invalid_argument);
+
+  // truncated
+  { ofstream f(path, ios::binary); f << "MDCSRBIN"; }
+  EXPECT_THROW(load_binary_graph(path.c_str()), std::invalid_argument);
+
+  // edge list
+  { ofstream f(path); f << "0 1\n"; }
+  EXPECT_THROW(load_binary_graph(path.c_str()), std::invalid_argument);
+  EXPECT_EQ(load_graph(path.c_str()).number_of_edges(), 1);
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "readwrite/dimacs.hpp"
+#include "readwrite/load_graph.hpp"
+#include "util/Random.hpp"
+
+using namespace std;
+using namespace readwrite;
+
+namespace {
+vector<vector<int>> adjacency(ds::graph::CSRGraph const& g) {
+  vector<vector<int>> ret;
+  for (std::size_t v = 0; v < g.number_of_nodes(); ++v) {
+    auto nbrs = g.neighbors(v);
+    ret.push_back(vector<int>(nbrs.begin(), nbrs.end()));
+  }
+  return ret;
+}
+
+ds::graph::CSRGraph pace(string const& s, int num_threads = 1) {
+  return parse_pace(s.data(), s.data() + s.size(), num_threads);
+}
+
+ds::graph::CSRGraph dimacs(string const& s, int num_threads = 1) {
+  return parse_dimacs(s.data(), s.data() + s.size(), num_threads);
+}
+}  // namespace
+
+TEST(DimacsTest, ParsePace) {
+  auto g = pace("c comment\np tw 5 4\n1 2\r\nc another comment\n\n2 3\n3 1\n5 2\n");
+  EXPECT_EQ(g.number_of_nodes(), 5);
+  EXPECT_EQ(g.number_of_edges(), 4);
+  EXPECT_EQ(adjacency(g), vector<vector<int>>({{1, 2}, {0, 2, 4}, {0, 1}, {}, {1}}));
+
+  EXPECT_EQ(pace("p tww 3 0\n").number_of_nodes(), 3);
+
+  EXPECT_THROW(pace(""), std::invalid_argument);
+  EXPECT_THROW(pace("1 2\np tw 2 1\n"), std::invalid_argument);
+  EXPECT_THROW(pace("p tw 2\n"), std::invalid_argument);
+  EXPECT_THROW(pace("p tw 2 1\n1 3\n"), std::invalid_argument);
+  EXPECT_THROW(pace("p tw 2 1\n0 1\n"), std::invalid_argument);
+  EXPECT_THROW(pace("p tw 2 1\n1\n"), std::invalid_argument);
+  EXPECT_THROW(pace("p tw 3 1\n1 2\n2 3\n"), std::invalid_argument);
+  EXPECT_THROW(pace("p tw 3 2\n1 2\n"), std::invalid_argument);
+}
+
+TEST(DimacsTest, ParseDimacs) {
+  auto g = dimacs("c comment\np edge 4 4\ne 1 2\ne 2 1\ne 3 4\n\ne 4 4\n");
+  EXPECT_EQ(g.number_of_nodes(), 4);
+  EXPECT_EQ(g.number_of_edges(), 2);
+  EXPECT_EQ(adjacency(g), vector<vector<int>>({{1}, {0}, {3}, {2}}));
+
+  EXPECT_EQ(dimacs("p col 2 1\ne 1 2").number_of_edges(), 1);
+
+  EXPECT_THROW(dimacs("e 1 2\n"), std::invalid_argument);
+  EXPECT_THROW(dimacs("p edge 2 1\n1 2\n"), std::invalid_argument);
+  EXPECT_THROW(dimacs("p edge 2 1\ne 1 3\n"), std::invalid_argument);
+}
+
+TEST(DimacsTest, ParseInParallel) {
+  util::Random rand(12345);
+  int n = 100000;
+  vector<pair<int, int>> edges;
+  string s = "p tw " + to_string(n) + " 400000\n";
+  for (int i = 0; i < 400000; ++i) {
+    int u = rand.randint(0, n - 1), v = rand.randint(0, n - 1);
+    edges.push_back({u, v});
+    s += to_string(u + 1) + " " + to_string(v + 1) + "\n";
+    if (i % 1000 == 0) s += "c comment\n";
+  }
+
+  auto expected = adjacency(ds::graph::CSRGraph(n, edges));
+  for (int num_threads : {1, 2, 3, 4}) EXPECT_EQ(adjacency(pace(s, num_threads)), expected);
+}
+
+TEST(DimacsTest, LoadGraph) {
+  string path = testing::TempDir() + "dimacs_test.txt";
+  auto load = [&](string const& s) {
+    { ofstream f(path); f << s; }
+    return adjacency(load_graph(path.c_str()));
+  };
+
+  EXPECT_EQ(load("c comment\np edge 3 1\ne 1 3\n"), vector<vector<int>>({{2}, {}, {0}}));
+  EXPECT_EQ(load("c comment\np tw 3 1\n1 3\n"), vector<vector<int>>({{2}, {}, {0}}));
+  EXPECT_EQ(load("# comment\n0 2\n"), vector<vector<int>>({{2}, {}, {0}}));
+
+  std::remove(path.c_str());
+}
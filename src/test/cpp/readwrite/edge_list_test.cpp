@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "readwrite/edge_list.hpp"
+#include "util/Random.hpp"
+
+using namespace std;
+using namespace readwrite;
+
+typedef std::vector<std::pair<int, int>> VII;
+
+namespace {
+pair<int, VII> parse(string const& s, int num_threads = 1) {
+  return parse_edge_list(s.data(), s.data() + s.size(), num_threads);
+}
+}  // namespace
+
+TEST(EdgeListTest, Parse) {
+  auto p = parse("# comment\n0 1\r\n\n  % another comment\n2\t3 0.5 extra\r\n\r\n   \n10 2");
+  EXPECT_EQ(p.first, 11);
+  EXPECT_EQ(p.second, VII({{0, 1}, {2, 3}, {10, 2}}));
+
+  EXPECT_EQ(parse("").first, 0);
+  EXPECT_EQ(parse("#\n").second, VII());
+
+  EXPECT_THROW(parse("0 1\n2\n"), std::invalid_argument);
+  EXPECT_THROW(parse("0 -1\n"), std::invalid_argument);
+  EXPECT_THROW(parse("0 x\n"), std::invalid_argument);
+  EXPECT_THROW(parse("0 2147483647\n"), std::invalid_argument);
+  EXPECT_THROW(parse("0 99999999999999999999999\n"), std::invalid_argument);
+}
+
+TEST(EdgeListTest, ParseInParallel) {
+  util::Random rand(12345);
+  VII expected;
+  string s;
+  for (int i = 0; i < 400000; ++i) {
+    int u = rand.randint(0, 99999), v = rand.randint(0, 99999);
+    expected.push_back({u, v});
+    s += to_string(u) + (i % 3 == 0 ? "\t" : " ") + to_string(v) + (i % 5 == 0 ? "\r\n" : "\n");
+    if (i % 1000 == 0) s += "# comment\n";
+  }
+
+  auto p1 = parse(s, 1);
+  EXPECT_EQ(p1.second, expected);
+  for (int num_threads : {2, 3, 4}) {
+    auto p = parse(s, num_threads);
+    EXPECT_EQ(p.first, p1.first);
+    EXPECT_EQ(p.second, expected);
+  }
+}
+
+TEST(EdgeListTest, ParseCSR) {
+  auto csr = [](string const& s, int num_threads = 1) {
+    return parse_edge_list_csr(s.data(), s.data() + s.size(), num_threads);
+  };
+
+  auto g = csr("# comment\n0 1\n1 0\n3 1\n5 5\n");
+  EXPECT_EQ(g.number_of_nodes(), 6);
+  EXPECT_EQ(g.number_of_edges(), 2);
+  EXPECT_EQ(g.degree(1), 2);
+  EXPECT_EQ(csr("").number_of_nodes(), 0);
+  EXPECT_THROW(csr("0 -1\n"), std::invalid_argument);
+
+  util::Random rand(12345);
+  VII edges;
+  string s;
+  for (int i = 0; i < 400000; ++i) {
+    int u = rand.randint(0, 99999), v = rand.randint(0, 99999);
+    edges.push_back({u, v});
+    s += to_string(u) + " " + to_string(v) + "\n";
+  }
+  int n = 0;
+  for (auto& e : edges) n = max(n, max(e.first, e.second) + 1);
+  auto expected = ds::graph::CSRGraph(n, edges);
+  for (int num_threads : {1, 2, 3, 4}) {
+    auto h = csr(s, num_threads);
+    ASSERT_EQ(h.number_of_nodes(), expected.number_of_nodes());
+    ASSERT_EQ(h.number_of_edges(), expected.number_of_edges());
+    EXPECT_TRUE(std::equal(h.targets(), h.targets() + 2 * h.number_of_edges(), expected.targets()));
+  }
+
+  // the graph overloads fill the adjacency sets directly
+  for (int num_threads : {1, 3}) {
+    std::istringstream is(s);
+    auto G = read_edge_list(is, num_threads);
+    ASSERT_EQ(G.number_of_nodes(), expected.number_of_nodes());
+    ASSERT_EQ(G.number_of_edges(), expected.number_of_edges());
+    EXPECT_FALSE(G.is_dense());
+    for (int v = 0; v < n; ++v) {
+      vector<int> xs;
+      for (auto u : G.neighbors(v)) xs.push_back(u);
+      auto t = expected.targets();
+      ASSERT_EQ(xs, vector<int>(t + expected.offsets()[v], t + expected.offsets()[v + 1]));
+    }
+  }
+}
+
+TEST(EdgeListTest, Load) {
+  string path = testing::TempDir() + "edge_list_test.txt";
+  {
+    ofstream f(path);
+    f << "% test\n0 1\n1 2\n2 0\n1 0\n4 4\n";
+  }
+
+  auto G = load_edge_list(path.c_str());
+  EXPECT_EQ(G.number_of_nodes(), 5);
+  EXPECT_EQ(G.number_of_edges(), 3);
+  EXPECT_TRUE(G.has_edge(2, 0));
+  EXPECT_FALSE(G.has_edge(4, 4));
+  EXPECT_TRUE(G.is_dense());
+
+  auto H = load_edge_list_csr(path.c_str(), 2);
+  EXPECT_EQ(H.number_of_nodes(), 5);
+  EXPECT_EQ(H.number_of_edges(), 3);
+  EXPECT_EQ(H.degree(4), 0);
+
+  std::istringstream is("0 1\n1 2\n");
+  EXPECT_EQ(read_edge_list_csr(is).number_of_edges(), 2);
+
+  std::remove(path.c_str());
+  EXPECT_THROW(load_edge_list(path.c_str()), std::invalid_argument);
+}
+
+TEST(EdgeListTest, Relabel) {
+  string s = "# hashed IDs\n9000000000000000000 -7\n-7 42\n42 9000000000000000000\n42 -7\n";
+  vector<int64_t> labels;
+  auto g = parse_edge_list_relabeled(s.data(), s.data() + s.size(), labels);
+  EXPECT_EQ(labels, vector<int64_t>({-7, 42, 9000000000000000000LL}));
+  EXPECT_EQ(g.number_of_nodes(), 3);
+  EXPECT_EQ(g.number_of_edges(), 3);
+
+  std::istringstream is("1000000 2000000\n");
+  EXPECT_EQ(read_edge_list_relabeled(is, labels).number_of_nodes(), 2);
+  EXPECT_EQ(labels, vector<int64_t>({1000000, 2000000}));
+
+  util::Random rand(12345);
+  s.clear();
+  vector<pair<int64_t, int64_t>> edges;
+  for (int i = 0; i < 300000; ++i) {
+    int64_t u = rand.randint<int64_t>(0, 999) * 1000000007LL, v = rand.randint<int64_t>(0, 999) * 1000000007LL;
+    edges.push_back({u, v});
+    s += to_string(u) + " " + to_string(v) + "\n";
+  }
+  auto h = parse_edge_list_relabeled(s.data(), s.data() + s.size(), labels, 4);
+  EXPECT_EQ(h.number_of_nodes(), labels.size());
+  for (auto& e : edges) {
+    if (e.first == e.second) continue;
+    int u = lower_bound(labels.begin(), labels.end(), e.first) - labels.begin();
+    int v = lower_bound(labels.begin(), labels.end(), e.second) - labels.begin();
+    auto nbrs = h.neighbors(u);
+    EXPECT_TRUE(binary_search(nbrs.begin(), nbrs.end(), v));
+  }
+}
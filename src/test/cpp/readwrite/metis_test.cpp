@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "readwrite/metis.hpp"
+#include "util/Random.hpp"
+
+using namespace std;
+using namespace readwrite;
+
+namespace {
+vector<vector<int>> adjacency(ds::graph::CSRGraph const& g) {
+  vector<vector<int>> ret;
+  for (std::size_t v = 0; v < g.number_of_nodes(); ++v) {
+    auto nbrs = g.neighbors(v);
+    ret.push_back(vector<int>(nbrs.begin(), nbrs.end()));
+  }
+  return ret;
+}
+
+ds::graph::CSRGraph metis(string const& s, int num_threads = 1) {
+  return parse_metis(s.data(), s.data() + s.size(), num_threads);
+}
+}  // namespace
+
+TEST(MetisTest, Parse) {
+  auto g = metis("% comment\n5 2\n3 2\n1\n1\r\n% another comment\n\n\n\n");
+  EXPECT_EQ(g.number_of_nodes(), 5);
+  EXPECT_EQ(g.number_of_edges(), 2);
+  EXPECT_EQ(adjacency(g), vector<vector<int>>({{1, 2}, {0}, {0}, {}, {}}));
+
+  // vertex sizes, two vertex weights and edge weights
+  g = metis("3 2 111 2\n7 1 1 2 5 3 6\n7 1 1 1 5\n7 1 1 1 6\n");
+  EXPECT_EQ(adjacency(g), vector<vector<int>>({{1, 2}, {0}, {0}}));
+
+  EXPECT_EQ(metis("0 0\n").number_of_nodes(), 0);
+
+  EXPECT_THROW(metis(""), std::invalid_argument);
+  EXPECT_THROW(metis("2 1 2\n2\n1\n"), std::invalid_argument);
+  EXPECT_THROW(metis("3 1\n2\n1\n"), std::invalid_argument);
+  EXPECT_THROW(metis("2 1\n2\n1\n1\n"), std::invalid_argument);
+  EXPECT_THROW(metis("2 1\n3\n1\n"), std::invalid_argument);
+  EXPECT_THROW(metis("2 1\n2\n\n"), std::invalid_argument);
+  EXPECT_THROW(metis("2 1 1\n2\n1\n"), std::invalid_argument);
+}
+
+TEST(MetisTest, ParseInParallel) {
+  util::Random rand(12345);
+  int n = 200000;
+  vector<pair<int, int>> edges;
+  for (int i = 0; i < 400000; ++i) {
+    int u = rand.randint(0, n - 1), v = rand.randint(0, n - 1);
+    if (u != v) edges.push_back({u, v});
+  }
+  auto g = ds::graph::CSRGraph(n, edges);
+
+  string s = to_string(n) + " " + to_string(g.number_of_edges()) + "\n";
+  for (int v = 0; v < n; ++v) {
+    if (v % 1000 == 0) s += "% comment\n";
+    for (auto u : g.neighbors(v)) s += to_string(u + 1) + " ";
+    s += "\n";
+  }
+
+  auto expected = adjacency(g);
+  for (int num_threads : {1, 2, 3, 4}) EXPECT_EQ(adjacency(metis(s, num_threads)), expected);
+}